@@ -1,12 +1,12 @@
 #version 450 core
 in vec2 TexCoords;
+in vec4 vColor;
 out vec4 color;
 
 uniform sampler2D text;
-uniform vec3 textColor;
 
 void main()
 {    
     vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-    color = vec4(textColor, 1.0) * sampled;
-} 
\ No newline at end of file
+    color = vColor * sampled;
+}
\ No newline at end of file
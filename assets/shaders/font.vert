@@ -1,12 +1,30 @@
 #version 450 core
-layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+
+// one glyph per instance, see Font::GlyphInstance
+layout (location = 0) in vec4 iRect;   // bottom left x, y, width, height
+layout (location = 1) in vec4 iUv;     // u0, v0 (top), u1, v1 (bottom)
+layout (location = 2) in vec4 iColor;
+
 out vec2 TexCoords;
+out vec4 vColor;
 
-uniform mat4 V;
-uniform mat4 P;
+// per frame constants, see renderer::FrameData
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 proj;
+    float time;
+    float deltaTime;
+    vec2 resolution;
+};
 
 void main()
 {
-    gl_Position = V * P * vec4(vertex.xy, 0.0, 1.0);
-    TexCoords = vertex.zw;
-} 
\ No newline at end of file
+    // drawn as a 4 vertex strip: bottom left, bottom right, top left, top right
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vec2 position = iRect.xy + corner * iRect.zw;
+
+    gl_Position = view * proj * vec4(position, 0.0, 1.0);
+    TexCoords = vec2(mix(iUv.x, iUv.z, corner.x), mix(iUv.w, iUv.y, corner.y));
+    vColor = iColor;
+}
\ No newline at end of file
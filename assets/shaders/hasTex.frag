@@ -2,13 +2,40 @@
 
 in vec4 vColor;
 in vec2 vTexCoord;
+flat in float vTexLayer;
+flat in int vTexSlot;
 out vec4 FragColor;
 
-uniform sampler2D uTex2d;
+// one per texture unit the draw list binds (renderer::TEXTURE_SLOTS). a multi draw
+// mixes textures, so the slot is picked with constant indices only
+uniform sampler2DArray uTex2d[16];
+
+vec4 sampleSlot(vec3 uv)
+{
+    switch (vTexSlot)
+    {
+    case 0: return textureLod(uTex2d[0], uv, 0.0);
+    case 1: return textureLod(uTex2d[1], uv, 0.0);
+    case 2: return textureLod(uTex2d[2], uv, 0.0);
+    case 3: return textureLod(uTex2d[3], uv, 0.0);
+    case 4: return textureLod(uTex2d[4], uv, 0.0);
+    case 5: return textureLod(uTex2d[5], uv, 0.0);
+    case 6: return textureLod(uTex2d[6], uv, 0.0);
+    case 7: return textureLod(uTex2d[7], uv, 0.0);
+    case 8: return textureLod(uTex2d[8], uv, 0.0);
+    case 9: return textureLod(uTex2d[9], uv, 0.0);
+    case 10: return textureLod(uTex2d[10], uv, 0.0);
+    case 11: return textureLod(uTex2d[11], uv, 0.0);
+    case 12: return textureLod(uTex2d[12], uv, 0.0);
+    case 13: return textureLod(uTex2d[13], uv, 0.0);
+    case 14: return textureLod(uTex2d[14], uv, 0.0);
+    default: return textureLod(uTex2d[15], uv, 0.0);
+    }
+}
 
 void main()
 {
-    vec4 texColor1 = texture(uTex2d, vTexCoord);
+    vec4 texColor1 = sampleSlot(vec3(vTexCoord, vTexLayer));
     if(texColor1.a <= 0.01)
     {
         discard;
@@ -4,18 +4,35 @@ layout(location = 0) in vec2 aPosition;
 layout(location = 1) in vec3 aColor;
 layout(location = 2) in vec2 aTexPos;
 
-layout(location = 3) in mat4 iModel;
-layout(location = 7) in vec4 iColor;
+// instance, see renderer::InstanceData
+layout(location = 3) in vec2 iPosition;
+layout(location = 4) in vec2 iScale;
+layout(location = 5) in vec2 iRotationDepth;   // rotation / pi, z
+layout(location = 6) in vec4 iColor;
 
-uniform mat4 V;
-uniform mat4 P;
+// per frame constants, see renderer::FrameData
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 proj;
+    float time;
+    float deltaTime;
+    vec2 resolution;
+};
 
 
 out vec4 vColor;
 
 void main()
 {
+    // translate * rotate * scale, as the CPU used to build it
+    float angle = iRotationDepth.x * 3.14159265;
+    float c = cos(angle);
+    float s = sin(angle);
+    vec2 scaled = aPosition * iScale;
+    vec2 world = vec2(c * scaled.x - s * scaled.y, s * scaled.x + c * scaled.y) + iPosition;
+
     //gl_Position = P * V * M * vec4(aPosition, 0.0, 1.0);
-    gl_Position = P * V * iModel * vec4(aPosition, 0.0, 1.0);
+    gl_Position = proj * view * vec4(world, iRotationDepth.y, 1.0);
     vColor = iColor;
 }
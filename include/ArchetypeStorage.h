@@ -0,0 +1,326 @@
+/* Start Header ************************************************************************/
+/*!
+\file		ArchetypeStorage.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Archetype based component storage. GameObjects that have exactly the same
+            set of components share an archetype, and each component type of that
+            archetype is kept in its own tightly packed array inside fixed size chunks.
+            Systems can then stream through e.g. every Transform + Physics pair
+            linearly instead of chasing one heap allocation per component.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <new>
+#include <cstddef>
+
+#include "Component.h" // ComponentTypes / componentID
+
+class GameObject;
+
+// Type erased description of a component type.
+// Lets the storage move, clone and destroy components without knowing the concrete type.
+struct ComponentTypeInfo {
+    ComponentID id;
+    size_t size;
+    size_t align;
+    void (*moveConstruct)(void* dst, void* src);
+    void (*cloneConstruct)(void* dst, const void* src);
+    void (*destroy)(void* ptr);
+
+    // one info per component type, created the first time that type is added to anything
+    template <typename T>
+    static const ComponentTypeInfo& get() {
+        static const ComponentTypeInfo info{
+            componentID<T>,
+            sizeof(T),
+            alignof(T),
+            [](void* dst, void* src) { ::new (dst) T(std::move(*static_cast<T*>(src))); },
+            [](void* dst, const void* src) {
+                // go through Component::clone() so per-type clone rules (e.g. AudioComponent
+                // dropping its live FMOD channels) still apply
+                auto copy = static_cast<const T*>(src)->clone();
+                ::new (dst) T(std::move(*static_cast<T*>(copy.get())));
+            },
+            [](void* ptr) { static_cast<T*>(ptr)->~T(); }
+        };
+        return info;
+    }
+};
+
+// Recycles the standard size chunks of every archetype in one storage. Freed chunks are
+// kept here instead of going back to the heap, so reloading a scene or churning objects
+// reuses the memory the last scene already paid for.
+class ChunkPool {
+public:
+    ChunkPool() = default;
+    ~ChunkPool();
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    std::byte* acquire();
+    void release(std::byte* chunk);
+
+    size_t getAllocatedCount() const { return m_allocated; }
+    size_t getFreeCount() const { return m_free.size(); }
+
+private:
+    std::vector<std::byte*> m_free;
+    size_t m_allocated = 0;
+};
+
+// All GameObjects with one particular set of components.
+// Rows are packed: row r lives in chunk r / capacity, slot r % capacity.
+class Archetype {
+public:
+    static constexpr size_t CHUNK_BYTES = 16 * 1024;
+    static constexpr size_t CHUNK_ALIGN = 64;
+
+    // types must be sorted by ComponentID and contain no duplicates
+    // chunks come from pool when given (and the row fits a standard chunk)
+    explicit Archetype(std::vector<const ComponentTypeInfo*> types, ChunkPool* pool = nullptr);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    const ComponentSignature& getSignature() const { return m_signature; }
+    const std::vector<const ComponentTypeInfo*>& getTypes() const { return m_types; }
+
+    // column of a component type, -1 if this archetype does not have it
+    int getColumn(ComponentID id) const { return m_columnOf[id]; }
+
+    size_t size() const { return m_size; }
+    size_t getChunkCount() const { return m_chunks.size(); }
+    size_t getChunkCapacity() const { return m_chunkCapacity; }
+    size_t getChunkSize(size_t chunk) const {
+        size_t first = chunk * m_chunkCapacity;
+        return (m_size - first < m_chunkCapacity) ? m_size - first : m_chunkCapacity;
+    }
+
+    GameObject** getOwners(size_t chunk) {
+        return reinterpret_cast<GameObject**>(m_chunks[chunk]);
+    }
+
+    void* getColumnData(size_t chunk, int column) {
+        return m_chunks[chunk] + m_columnOffsets[column];
+    }
+
+    void* getComponent(size_t row, int column) {
+        return m_chunks[row / m_chunkCapacity] + m_columnOffsets[column]
+            + (row % m_chunkCapacity) * m_types[column]->size;
+    }
+
+    GameObject*& getOwner(size_t row) {
+        return getOwners(row / m_chunkCapacity)[row % m_chunkCapacity];
+    }
+
+    // appends a row for owner, the component memory is left unconstructed
+    size_t pushRow(GameObject* owner);
+
+    // destroys every component in row and moves the last row into the gap
+    // returns the GameObject that was moved into row, nullptr if nothing moved
+    GameObject* removeRow(size_t row);
+
+    // cached archetype transitions so adding/removing a component skips the lookup
+    std::array<Archetype*, MAX_COMPONENTS> addEdges{};
+    std::array<Archetype*, MAX_COMPONENTS> removeEdges{};
+
+private:
+    std::byte* allocateChunk();
+    void freeChunk(std::byte* chunk);
+
+    std::vector<const ComponentTypeInfo*> m_types;
+    ComponentSignature m_signature;
+    std::array<int, MAX_COMPONENTS> m_columnOf;
+    std::vector<size_t> m_columnOffsets;
+    size_t m_chunkCapacity = 1;
+    size_t m_chunkBytes = CHUNK_BYTES;
+
+    std::vector<std::byte*> m_chunks;
+    size_t m_size = 0;
+    ChunkPool* m_pool = nullptr;
+};
+
+// Every archetype whose signature contains mask. Archetypes are never destroyed, so the
+// list only ever grows: the storage appends each newly created archetype to the queries
+// it matches. Objects moving between archetypes need no bookkeeping at all.
+struct ArchetypeQuery {
+    ComponentSignature mask;
+    std::vector<Archetype*> archetypes;
+};
+
+// One chunk of one archetype, the unit parallel loops split a view into.
+struct ArchetypeChunk {
+    Archetype* archetype;
+    size_t chunk;
+};
+
+// Typed handle to a cached query, e.g. manager.view<Transform, Physics>().
+// Cheap to create and copy, it only points at the query owned by the storage.
+template <typename... Ts>
+class View {
+public:
+    static_assert(sizeof...(Ts) > 0, "View<> needs at least one component type");
+
+    explicit View(ArchetypeQuery& query) : m_query(&query) {}
+
+    // calls fn(GameObject&, Ts&...) for every matching object, chunk by chunk.
+    // do not add/remove components or objects from inside fn, use collect() for that
+    template <typename Fn>
+    void each(Fn&& fn) const {
+        // only walk the archetypes that exist right now
+        const size_t archetypeCount = m_query->archetypes.size();
+        for (size_t a = 0; a < archetypeCount; ++a) {
+            Archetype& archetype = *m_query->archetypes[a];
+            if (archetype.size() == 0) continue;
+
+            const int columns[] = { archetype.getColumn(componentID<Ts>)... };
+            for (size_t chunk = 0; chunk < archetype.getChunkCount(); ++chunk) {
+                eachInChunk(archetype, chunk, columns, fn, std::index_sequence_for<Ts...>{});
+            }
+        }
+    }
+
+    // first object for which pred(GameObject&, Ts&...) returns true, nullptr if none
+    template <typename Pred>
+    GameObject* find(Pred&& pred) const {
+        for (Archetype* archetype : m_query->archetypes) {
+            const int columns[] = { archetype->getColumn(componentID<Ts>)... };
+            for (size_t row = 0; row < archetype->size(); ++row) {
+                if (testRow(*archetype, row, columns, pred, std::index_sequence_for<Ts...>{})) {
+                    return archetype->getOwner(row);
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // every non-empty matching chunk, in the same order each() visits them.
+    // hand slices of this to JobSystem::parallelFor and call eachIn() per chunk
+    void collectChunks(std::vector<ArchetypeChunk>& out) const {
+        out.clear();
+        for (Archetype* archetype : m_query->archetypes) {
+            for (size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) out.push_back({ archetype, chunk });
+        }
+    }
+
+    // each() for a single chunk from collectChunks(), different chunks can run on different threads
+    template <typename Fn>
+    void eachIn(const ArchetypeChunk& chunk, Fn&& fn) const {
+        const int columns[] = { chunk.archetype->getColumn(componentID<Ts>)... };
+        eachInChunk(*chunk.archetype, chunk.chunk, columns, fn, std::index_sequence_for<Ts...>{});
+    }
+
+    // snapshot of the matching objects, for systems that may change components while looping
+    void collect(std::vector<GameObject*>& out) const {
+        out.clear();
+        out.reserve(size());
+        for (Archetype* archetype : m_query->archetypes) {
+            for (size_t row = 0; row < archetype->size(); ++row) out.push_back(archetype->getOwner(row));
+        }
+    }
+
+    size_t size() const {
+        size_t count = 0;
+        for (Archetype* archetype : m_query->archetypes) count += archetype->size();
+        return count;
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    template <typename Fn, size_t... I>
+    static void eachInChunk(Archetype& archetype, size_t chunk, const int* columns, Fn& fn, std::index_sequence<I...>) {
+        GameObject** owners = archetype.getOwners(chunk);
+        std::tuple<Ts*...> data{ static_cast<Ts*>(archetype.getColumnData(chunk, columns[I]))... };
+
+        const size_t count = archetype.getChunkSize(chunk);
+        for (size_t i = 0; i < count; ++i) {
+            fn(*owners[i], std::get<I>(data)[i]...);
+        }
+    }
+
+    template <typename Pred, size_t... I>
+    static bool testRow(Archetype& archetype, size_t row, const int* columns, Pred& pred, std::index_sequence<I...>) {
+        return pred(*archetype.getOwner(row), *static_cast<Ts*>(archetype.getComponent(row, columns[I]))...);
+    }
+
+    ArchetypeQuery* m_query;
+};
+
+// Owns every archetype for one set of GameObjects (normally one GameObjectManager).
+// Component pointers handed out stay valid until the owning object, or another object
+// in the same archetype, gains or loses a component.
+class ArchetypeStorage {
+public:
+    ArchetypeStorage();
+    ~ArchetypeStorage();
+
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+    // storage used by objects that do not belong to a GameObjectManager (editor prefabs, temp text)
+    static ArchetypeStorage& detached();
+
+    // called by GameObject on construction/destruction
+    void attach(GameObject& obj);
+    void detach(GameObject& obj);
+
+    // returns unconstructed memory for the new component, caller placement-news into it
+    // if obj already has this type the old component is destroyed and its slot reused
+    void* addComponent(GameObject& obj, const ComponentTypeInfo& info);
+    bool removeComponent(GameObject& obj, ComponentID id);
+
+    // clones every component of src onto dst, dst must not have any components yet
+    void cloneComponents(const GameObject& src, GameObject& dst);
+
+    // cached query for every object that has all of Ts, built on first use
+    template <typename... Ts>
+    View<Ts...> view() {
+        return View<Ts...>(getQuery(makeSignature<Ts...>()));
+    }
+
+    // calls fn(GameObject&, Ts&...) for every object that has all of Ts
+    template <typename... Ts, typename Fn>
+    void each(Fn&& fn) {
+        view<Ts...>().each(std::forward<Fn>(fn));
+    }
+
+    const std::vector<std::unique_ptr<Archetype>>& getArchetypes() const { return m_archetypes; }
+    const ChunkPool& getChunkPool() const { return m_chunkPool; }
+
+private:
+    ArchetypeQuery& getQuery(const ComponentSignature& mask);
+
+    Archetype* findOrCreate(std::vector<const ComponentTypeInfo*> types);
+
+    // moves obj's components that dst also has into a new row of dst
+    void migrate(GameObject& obj, Archetype& dst);
+
+    // fixes the row index of an object that removeRow() moved
+    static void relocate(GameObject* moved, size_t row);
+
+    ChunkPool m_chunkPool; // declared before the archetypes so it outlives them
+    std::vector<std::unique_ptr<Archetype>> m_archetypes;
+    std::unordered_map<ComponentSignature, Archetype*> m_lookup;
+    std::unordered_map<ComponentSignature, std::unique_ptr<ArchetypeQuery>> m_queries;
+    std::mutex m_queryMutex; // systems on different threads can ask for a view at the same time
+    Archetype* m_root = nullptr; // archetype with no components
+};
@@ -27,6 +27,7 @@ Technology is prohibited.
 #include "mathlib.h"
 #include "font.h"
 #include "dynamics.h"
+#include "ComponentFamily.h"
 
 
 // at least it works!!!
@@ -50,7 +51,7 @@ struct Transform : public Component {
 public:
     Transform() = default;
     Transform(float px, float py, float pz, float rot, float sx, float sy, float sz)
-        : x(px), y(py), z(pz), rotation(rot), scaleX(sx), scaleY(sy), scaleZ(sz), mdlWorld(1) {
+        : x(px), y(py), z(pz), rotation(rot), scaleX(sx), scaleY(sy), scaleZ(sz) {
     }
 
     std::unique_ptr<Component> clone() const override {
@@ -61,7 +62,33 @@ public:
     float rotation = 0.0f;
     float scaleX = 1.0f, scaleY = 1.0f, scaleZ{ 0.f };
     bool flipX = false; // flip scaleX when change direction, true means flip to left
-    glm::mat4 mdlWorld = 1.f;
+
+    // bumped by everything that moves, rotates, scales or flips the object, the
+    // hierarchy pass uses it to see what changed
+    std::uint32_t version = 1;
+
+    void markDirty() { ++version; }
+
+    // offset from the parent while the object has one, see TransformHierarchy. x/y/rotation
+    // above stay the world values, the hierarchy pass keeps them following the parent
+    float localX{ 0.f }, localY{ 0.f }, localRotation{ 0.f };
+    bool localFlipX = false;     // facing the other way from the parent
+    bool localDirty = false;     // local values were written, world follows them next pass
+    std::uint32_t resolvedVersion = 0; // own version after the last hierarchy pass
+    std::uint32_t parentVersion = 0;   // parent's version at the last hierarchy pass
+
+    // after writing localX/localY/localRotation directly
+    void markLocalDirty() { localDirty = true; }
+
+    // position at the start of the last simulation step, render draws in between
+    // that and x/y. not saved, snapshotInterpolation fills it every step
+    float prevX{ 0.f }, prevY{ 0.f };
+    bool hasPrev = false;
+
+    void snapshotInterpolation() { prevX = x; prevY = y; hasPrev = true; }
+
+    // call after teleporting so the object does not slide over from where it was
+    void resetInterpolation() { hasPrev = false; }
 };
 
 // Render component to store rendering-related properties
@@ -78,6 +105,9 @@ public:
     bool hasTex = false;
     bool isTransparent = false;
     bool hasAnimation = false;
+    // does not move: drawn from a static batch that is only rebuilt when the object is
+    // edited, instead of being batched every frame. only for textured, unanimated objects
+    bool isStatic = false;
     //bool wireframe = false;
     // sorry but i need this for real time texture update
     // wait for boss sin le to help me settle this - kelly :)
@@ -96,7 +126,6 @@ struct FontComponent : public Component {
     }
 
     //GLuint texHdl;
-    Font::FontMdl mdl = Font::fontMdls[0];
     std::string word = "";
     float scale = 1;
     glm::vec3 clr{ 0.f,0.f,0.f };
@@ -462,6 +491,10 @@ struct TileMap : public Component
     };
     std::unordered_map<TileKey, std::string, TileKeyHash> tiles;
 
+    // moves on with every setTile/clearTile, TileMapSystem rebuilds its static batches
+    // when it differs from what they were built from
+    std::uint32_t revision = 0;
+
     std::string getTile(int x, int y) const {
         TileKey key{ x, y };
         auto it = tiles.find(key);
@@ -471,10 +504,35 @@ struct TileMap : public Component
     void setTile(int x, int y, std::string tileID) {
         if (x >= -columns && x < columns && y >= -rows && y < rows) {
             tiles[{x, y}] = tileID;
+            ++revision;
         }
     }
 
     void clearTile(int x, int y) {
-        tiles.erase({ x, y });
+        if (tiles.erase({ x, y })) ++revision;
     }
-};
\ No newline at end of file
+
+    void clearTiles() {
+        tiles.clear();
+        ++revision;
+    }
+};
+
+/* ---------------- Component IDs ---------------- */
+// every component that can be added to a GameObject, the position in the list is its ComponentID
+// add new components at the back so the existing IDs do not shift
+using ComponentTypes = ComponentList<Transform, Render, FontComponent, Animation, Physics, Input,
+    CollisionInfo, LuaScript, StateMachine, AudioComponent, TileMap>;
+
+static_assert(ComponentTypes::count <= MAX_COMPONENTS, "Too many component types, raise MAX_COMPONENTS");
+
+template <typename T>
+inline constexpr ComponentID componentID = ComponentIndex<T, ComponentTypes>::value;
+
+// signature with the bit of every T set, e.g. makeSignature<Transform, Physics>()
+template <typename... Ts>
+inline ComponentSignature makeSignature() {
+    ComponentSignature signature;
+    (signature.set(componentID<Ts>), ...);
+    return signature;
+}
\ No newline at end of file
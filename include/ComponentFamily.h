@@ -0,0 +1,56 @@
+/* Start Header ************************************************************************/
+/*!
+\file		ComponentFamily.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Compile time component IDs. Every component type is listed once in
+            ComponentTypes (bottom of Component.h) and its position in that list is
+            its ID, so has/get checks are a bit test and an array index instead of
+            hashing typeid() at runtime.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <type_traits>
+
+using ComponentID = std::uint8_t;
+
+// max number of component types, bump this if ComponentTypes ever grows past it
+constexpr size_t MAX_COMPONENTS = 32;
+
+// one bit per component type
+using ComponentSignature = std::bitset<MAX_COMPONENTS>;
+
+template <typename... Ts>
+struct ComponentList {
+    static constexpr size_t count = sizeof...(Ts);
+};
+
+// position of T inside a ComponentList
+template <typename T, typename List>
+struct ComponentIndex;
+
+template <typename T>
+struct ComponentIndex<T, ComponentList<>> {
+    static_assert(!std::is_same_v<T, T>, "Component type is not listed in ComponentTypes (Component.h)");
+    static constexpr ComponentID value = 0;
+};
+
+template <typename T, typename... Rest>
+struct ComponentIndex<T, ComponentList<T, Rest...>> {
+    static constexpr ComponentID value = 0;
+};
+
+template <typename T, typename U, typename... Rest>
+struct ComponentIndex<T, ComponentList<U, Rest...>> {
+    static constexpr ComponentID value = 1 + ComponentIndex<T, ComponentList<Rest...>>::value;
+};
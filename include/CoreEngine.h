@@ -32,6 +32,10 @@ Technology is prohibited.
 #include "GUISystem.h"
 #include "messageBus.h"
 #include "JsonIO.h"
+#include "JobSystem.h"
+#include "SystemScheduler.h"
+#include "InputRecorder.h"
+#include "World.h"
 
 
 class CoreEngine {
@@ -45,6 +49,22 @@ public:
     // Runs the main game loop
     void Run();
 
+    // no window, GL context, FMOD or ImGui. loads the scene (a file name in the runtime
+    // scene folder or a path) and registers only the simulation systems, see RunHeadless.
+    // worlds > 1 loads that many independent copies of the scene instead (--worlds)
+    void InitHeadless(const std::string& scene, int worlds = 1);
+
+    // runs frames fixed steps back to back as fast as possible, then prints the
+    // simulated frames per second. returns the exit code for main
+    int RunHeadless(int frames);
+
+    // --record: saves the played session (from the moment a level is playing) to path
+    void RecordTo(const std::string& path) { m_recordPath = path; }
+
+    // --replay: plays the session in path back instead of the keyboard/mouse, starting
+    // straight in its scene. call before Init/InitHeadless, false if it can not be read
+    bool ReplayFrom(const std::string& path);
+
     // Shuts down all engine systems
     void Shutdown();
 
@@ -55,7 +75,17 @@ public:
 private:
     void GameLoop();
     void Update(float deltaTime);
-    double m_fixedDt = 1.0 / 60.0; // 60 Hz simulation
+
+    // builds the per frame system graph around m_world's, see Update
+    void registerSystems();
+
+    // RunHeadless with more than one world: every world on its own thread
+    int runWorlds(int frames);
+
+    double m_fixedDt = 1.0 / 60.0; // 60 Hz simulation, from config
+    int m_maxSteps = 5;            // fixed steps per frame at most, from config
+    int m_simSteps = 0;            // fixed steps due this frame
+    double m_alpha = 0.0;          // how far into the next step this frame is, for render interpolation
 
     // Window and timing variables
     GLFWwindow* m_window;
@@ -70,6 +100,10 @@ private:
     int  m_windowPosX = 100;
     int  m_windowPosY = 100;
     bool m_forceWindowed = false;
+    bool m_headless = false;       // InitHeadless, nothing graphical exists
+
+    InputRecorder m_recorder;
+    std::string m_recordPath;      // starts recording once a level is playing
 	bool m_isPaused; //for alt-tab pause
 
     //hardcoded bgm player
@@ -86,20 +120,22 @@ private:
     std::unique_ptr<GUISystem> m_guiSystem;
 
 
+    // the simulated level: objects, message bus, Lua and the simulation systems
+    std::unique_ptr<World> m_world;
+    GameObjectManager* m_manager = nullptr; // m_world's
+
+    // --worlds: headless copies of the level stepped side by side, m_world stays empty
+    std::vector<std::unique_ptr<World>> m_batchWorlds;
+
     // Core Engine Systems
-    std::unique_ptr<GameObjectManager> m_manager;
     std::unique_ptr<InputSystem> m_inputSystem;
-    std::unique_ptr<CollisionSystem> m_collisionSystem;
-    std::unique_ptr<PhysicsSystem> m_physicsSystem;
     std::unique_ptr<RenderSystem> m_renderSystem;
 #ifdef _DEBUG
     std::unique_ptr<UISystem> m_uiSystem;
 #endif
-    std::unique_ptr<LuaSystem> m_luaSystem;
     std::unique_ptr<FontSystem> m_fontSystem;
-    std::unique_ptr<LogicSystem> m_logicSystem;
-    std::unique_ptr<MessageBus> m_messageBus;
-    std::unique_ptr<PlayerControllerSystem> m_playerController;
     std::unique_ptr<AudioSystem> m_audioSystem;
     std::unique_ptr<TileMapSystem> m_tileMapSystem;
+
+    std::unique_ptr<SystemScheduler> m_scheduler;    // once per frame, m_world's graphs run inside it
 };
@@ -100,10 +100,17 @@ public:
 
 private:
 	void handlePrefabDragDrop(GameObjectManager& manager);
+
+	// one object and, under it, its children. indices maps objects back to their position in the list
+	void renderNode(GameObjectManager& manager, GameObject* obj, const std::unordered_map<GameObject*, int>& indices);
+
+	// dragging one object onto another attaches it there
+	void handleReparentDragDrop(GameObjectManager& manager, GameObject* target);
+
 	void showContextMenu(GameObjectManager& manager, GameObject* obj, int objIndex);
 
 	void objDeletePopup(GameObjectManager& manager);
-	void createPrefabPopup();
+	void createPrefabPopup(GameObjectManager& manager);
 
 	Editor::ObjSelectionState& m_objSelectionState;
 };
@@ -166,7 +173,7 @@ private:
 // Performance
 class PerformanceWindow {
 public:
-	void render();
+	void render(GameObjectManager& manager);
 };
 
 // Scene Window & Editor Camera Window
@@ -210,7 +217,7 @@ private:
 	// handle click and select logic and collision
 	void objPicking(GameObjectManager& manager);
 	// handle dragging of the obj (obj will follow cursor)
-	void objDragging() const;
+	void objDragging(GameObjectManager& manager) const;
 	/* -------- END -------- */
 
 	AssetBrowser& m_assetBrowser;
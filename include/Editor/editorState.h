@@ -38,12 +38,13 @@ namespace Editor {
 
 	/* ----------------- Game Object Selection -----------------*/
 	struct ObjSelectionState {
-		GameObject* selectedObject = nullptr; // currently selected object
+		// handles, not pointers, so a selection whose object got deleted just resolves to nullptr
+		EntityHandle selectedObject; // currently selected object
 		int selectedIndex = -1; // index of selected object in the list
 
 		std::unique_ptr<GameObject> selectedPrefab;
 
-		GameObject* draggedObject = nullptr; // currently dragged object
+		EntityHandle draggedObject; // currently dragged object
 
 		bool aspectRatioLock = true; // lock aspect ratio for resizing
 		bool ratioSet = false;
@@ -21,6 +21,8 @@ Technology is prohibited.
 #pragma once
 #include <vector>
 #include <string>
+#include <mutex>
+#include <algorithm>
 
 enum class DebugMode {
     Editor, // means editing
@@ -36,6 +38,8 @@ class DebugLog {
 public:
     // add a message with current mode
     static void addMessage(const std::string& msg, DebugMode mode = DebugMode::Editor) {
+        // systems on worker threads log too
+        std::lock_guard<std::mutex> lock(mutex);
         messages.push_back({ msg, mode });
 
         if (mode == DebugMode::Editor) {
@@ -55,15 +59,17 @@ public:
 
     // clear all play simulation msg (when simulation stop)
     static void clearPlaySimulMsg() {
+        std::lock_guard<std::mutex> lock(mutex);
         messages.erase(std::remove_if(messages.begin(), messages.end(),
             [](const DebugMessage& msg) { return msg.mode == DebugMode::PlaySimul;}), messages.end());
     }
 
-    // get all messages
+    // get all messages, main thread only while no system is running
     static const std::vector<DebugMessage>& getMessages() {
         return messages;
     }
 
 private:
     static inline std::vector<DebugMessage> messages;
+    static inline std::mutex mutex;
 };
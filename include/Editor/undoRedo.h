@@ -41,15 +41,15 @@ public:
 	virtual void execute() = 0;
 	virtual void undo() = 0;
 
-	// to be override in derived class, store obj name (in case of rename)
-	virtual void updateObjName(const std::string&, const std::string&) {}
+	// to be override in derived class, an undo/redo recreated the obj so it has a new handle
+	virtual void remapHandle(EntityHandle, EntityHandle) {}
 };
 
 // store transform changes
 class TransformCmd : public CmdInterface {
 public:
 	// ctor with before/other state
-	TransformCmd(GameObjectManager& manager, const std::string& objName, const TransformSnapshot& before, const TransformSnapshot& after);
+	TransformCmd(GameObjectManager& manager, EntityHandle handle, const TransformSnapshot& before, const TransformSnapshot& after);
 
 	// apply AFTER transform snapshot (final position aft transform changed)
 	void execute() override;
@@ -57,15 +57,15 @@ public:
 	// apply BEFORE transform snapshot (put back to initial transform)
 	void undo() override;
 
-	// if renamed, save the old name and new name (so undo/redo still work)
-	void updateObjName(const std::string& oldName, const std::string& newName);
+	// obj was deleted and recreated by another command, follow it
+	void remapHandle(EntityHandle oldHandle, EntityHandle newHandle) override;
 
 private:
 	// helper to write transform data to a game obj
 	void applySnapshot(const TransformSnapshot& snap);
 
 	GameObjectManager& m_manager;
-	std::string m_objectName;
+	EntityHandle m_handle;
 	TransformSnapshot m_before;
 	TransformSnapshot m_after;
 };
@@ -73,7 +73,7 @@ private:
 // store obj creation
 class CreateObjectCmd : public CmdInterface {
 public:
-	CreateObjectCmd(GameObjectManager& manager, const std::string& objName);
+	CreateObjectCmd(GameObjectManager& manager, GameObject* obj);
 
 	// create obj (serialize to save it)
 	void execute() override;
@@ -81,12 +81,12 @@ public:
 	// delete the created obj (undo the creation)
 	void undo() override;
 
-	// if renamed, save the old name and new name (so undo/redo still work)
-	void updateObjName(const std::string& oldName, const std::string& newName);
+	// obj was deleted and recreated by another command, follow it
+	void remapHandle(EntityHandle oldHandle, EntityHandle newHandle) override;
 
 private:
 	GameObjectManager& m_manager;
-	std::string m_objectName;
+	EntityHandle m_handle;
 	std::string m_serializedData;
 	bool m_wasExecuted = false;
 };
@@ -102,12 +102,12 @@ public:
 	// recreate obj from serialized data (undo the deletion)
 	void undo() override;
 
-	// if renamed, save the old name and new name (so undo/redo still work)
-	void updateObjName(const std::string& oldName, const std::string& newName);
+	// obj was deleted and recreated by another command, follow it
+	void remapHandle(EntityHandle oldHandle, EntityHandle newHandle) override;
 
 private:
 	GameObjectManager& m_manager;
-	std::string m_objectName;
+	EntityHandle m_handle;
 	std::string m_serializedData;
 	int m_layer = 0;
 };
@@ -123,8 +123,8 @@ public:
 	// exesute and store a command
 	void executeCmd(std::unique_ptr<CmdInterface> cmd);
 
-	// if renamed, save the old name and new name (so undo/redo still work)
-	void updateObjName(const std::string& oldName, const std::string& newName);
+	// point every stored command at the recreated obj (handles survive renames, not delete + recreate)
+	void remapHandle(EntityHandle oldHandle, EntityHandle newHandle);
 
 	// undo last command
 	void undo();
@@ -158,7 +158,7 @@ private:
 
 	// for transform
 	bool m_isEditingTransform = false;
-	std::string m_editingObjName;
+	EntityHandle m_editingHandle;
 	TransformSnapshot m_transformBefore;
 };
 
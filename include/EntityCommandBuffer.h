@@ -0,0 +1,87 @@
+/* Start Header ************************************************************************/
+/*!
+\file		EntityCommandBuffer.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Deferred structural changes. Creating/destroying objects, adding/removing
+            components and renaming all move rows around in the archetype storage,
+            which invalidates the component pointers a system is iterating over.
+            Systems record those changes here instead and CoreEngine plays them back
+            at fixed sync points in the frame, when nothing is iterating.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <utility>
+
+#include "EntityHandle.h"
+#include "GameObject.h"
+
+class GameObjectManager;
+
+class EntityCommandBuffer {
+public:
+    using ObjectFn = std::function<void(GameObject&)>;
+
+    EntityCommandBuffer() = default;
+
+    EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+    EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+    // creates name at playback, init (if any) runs on the new object straight after,
+    // so its components can be added there
+    void create(const std::string& name, ObjectFn init = nullptr);
+
+    void destroy(EntityHandle handle);
+    void rename(EntityHandle handle, const std::string& newName);
+
+    // args are copied now and forwarded to T's constructor at playback
+    template <typename T, typename... TArgs>
+    void addComponent(EntityHandle handle, TArgs... args) {
+        invoke(handle, [args...](GameObject& obj) mutable {
+            obj.addComponent<T>(std::move(args)...);
+        });
+    }
+
+    template <typename T>
+    void removeComponent(EntityHandle handle) {
+        invoke(handle, [](GameObject& obj) { obj.removeComponent<T>(); });
+    }
+
+    // any other work on one object that has to wait for the sync point,
+    // e.g. setting up a component that was added earlier in the same buffer
+    void invoke(EntityHandle handle, ObjectFn fn);
+
+    // applies every recorded command in order. commands aimed at an object that is
+    // gone by then are skipped, commands recorded during playback run in the same call
+    void playback(GameObjectManager& manager);
+
+    // drops everything not played back yet (scene switch)
+    void clear() { m_commands.clear(); }
+
+    bool empty() const { return m_commands.empty(); }
+    size_t size() const { return m_commands.size(); }
+
+private:
+    enum class CommandType { Create, Destroy, Rename, Invoke };
+
+    struct Command {
+        CommandType type;
+        EntityHandle handle;
+        std::string name;
+        ObjectFn fn;
+    };
+
+    std::vector<Command> m_commands;
+    std::vector<Command> m_playing; // batch being played back, kept to reuse its memory
+};
@@ -0,0 +1,55 @@
+/* Start Header ************************************************************************/
+/*!
+\file		EntityHandle.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Generational handle to a GameObject owned by a GameObjectManager.
+            A handle is the object's slot in the manager plus the generation of
+            that slot. Deleting an object bumps the generation, so any handle still
+            pointing at it (undo history, Lua, editor selection) simply fails to
+            resolve instead of dangling or landing on whatever reuses the slot.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+struct EntityHandle {
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    // never pointed at anything (default constructed / temp object)
+    // a non-null handle can still be stale, ask the manager to resolve it
+    bool isNull() const { return index == INVALID_INDEX; }
+
+    // packed into one 64 bit value, used to hand the handle to Lua as an integer
+    std::uint64_t toBits() const {
+        return (static_cast<std::uint64_t>(generation) << 32) | index;
+    }
+
+    static EntityHandle fromBits(std::uint64_t bits) {
+        return EntityHandle{ static_cast<std::uint32_t>(bits & 0xFFFFFFFFu), static_cast<std::uint32_t>(bits >> 32) };
+    }
+
+    bool operator==(const EntityHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// so handles can be used as map keys
+struct EntityHandleHash {
+    size_t operator()(const EntityHandle& handle) const {
+        return std::hash<std::uint64_t>{}(handle.toBits());
+    }
+};
@@ -57,7 +57,7 @@ public:
 private:
     void createButtons(GameObjectManager& manager); //create menu buttons
     void removeButtons(GameObjectManager& manager); //remove menu buttons
-	void startGame(GameObjectManager& manager); //start game
+	void startGame(GameObjectManager& manager, const std::string& scene = "level01.json"); //start game
     void stopGame(); //stop game	
 
     bool isPointInButton(const Vector2D& point, GameObject* button);
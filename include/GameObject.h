@@ -17,16 +17,23 @@ Technology is prohibited.
 #pragma once
 
 #include "Component.h"
+#include "ArchetypeStorage.h"
+#include "EntityHandle.h"
 #include <vector>
 #include <unordered_map>
 #include <string>
 #include <memory>
-#include <typeindex>//use this for typeid to make it map-friendly
 
 class GameObject {
 public:
 	//constructor
-    GameObject(const std::string& name, const std::string& prefabID = "");
+    //storage is where the components live, objects without a manager use the detached storage
+    GameObject(const std::string& name, const std::string& prefabID = "", ArchetypeStorage* storage = nullptr);
+    ~GameObject();
+
+    //components live in the storage rows, so the object itself cannot be copied around
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
 
 	// Adds a component of type T to the game object
     template <typename T, typename... TArgs>//typename... is a variadic template
@@ -36,51 +43,52 @@ public:
         //basically allows me to make a template for a component
         //with any number of arguments
 
+        //the storage moves this object into the archetype that also has T
+        //and hands back the slot for the new component
+        void* slot = m_storage->addComponent(*this, ComponentTypeInfo::get<T>());
+
         //std::forward reverts the argument to its state before
         //it was passed through the function
-        auto newComponent = std::make_unique<T>(std::forward<TArgs>(args)...);
-        T* componentPtr = newComponent.get();
-
-        //attach this new component to a map of them
-        m_components[std::type_index(typeid(T))] = std::move(newComponent);
-        //typeid() creates a unique id of type type_info
-		//type_info is a unique type information that can only have one instance
-		//type_index is a wrapper around type_info that allows it to be used in any container
-
-        return componentPtr;
+        //NOTE: this moves the other components of this object too, so refetch
+        //any component pointers you were holding on to
+        return ::new (slot) T(std::forward<TArgs>(args)...);
     }
 
 	// Gets the component of type T if it exists, otherwise returns nullptr
     template <typename T>
     T* getComponent() {
-        auto iterator = m_components.find(std::type_index(typeid(T)));//look through map
-        if (iterator != m_components.end()) {//if component was found
-            //get that thang
-            return static_cast<T*>(iterator->second.get());
-        }
+        //componentID<T> is fixed at compile time, the archetype maps it straight to a column
+        int column = m_archetype->getColumn(componentID<T>);
+        if (column < 0) return nullptr;
 
-        return nullptr;
+        return static_cast<T*>(m_archetype->getComponent(m_row, column));
     }
 
     // Gets the component of type T (const overload)
     template <typename T>
     const T* getComponent() const {
-        auto it = m_components.find(std::type_index(typeid(T)));
-        if (it != m_components.end()) {
-            return static_cast<const T*>(it->second.get());
-        }
-        return nullptr;
+        int column = m_archetype->getColumn(componentID<T>);
+        if (column < 0) return nullptr;
+
+        return static_cast<const T*>(m_archetype->getComponent(m_row, column));
     }
 
 	// Checks if the game object has a component of type T
     template <typename T>
     bool hasComponent() const {
-        //count returns number of keys found in the map
-        //unordered map does not allow duplicate keys
-        //so will return 1 or 0
-        return m_components.count(std::type_index(typeid(T)));
+        return m_archetype->getSignature().test(componentID<T>);
     }
 
+    // Checks if the game object has every one of Ts, single mask test
+    template <typename... Ts>
+    bool hasComponents() const {
+        static const ComponentSignature mask = makeSignature<Ts...>();
+        return (m_archetype->getSignature() & mask) == mask;
+    }
+
+    // bit per component this object currently has
+    const ComponentSignature& getSignature() const { return m_archetype->getSignature(); }
+
     std::unique_ptr<GameObject> clone(const std::string& name) const;
 
 	// Returns the name of the game object
@@ -92,6 +100,9 @@ public:
 	const int& getLayer() const;
 	bool isOnLayer(int layerID) const;
 
+    // handle given by the manager that owns this object, null for temp objects
+    EntityHandle getHandle() const { return m_handle; }
+
     // Return prefab ID of the game obj
     const std::string& getObjectPrefabID() const;
     std::string& getObjectPrefabID();
@@ -102,21 +113,24 @@ public:
 	//remove component of type T
     template <typename T>
     bool removeComponent() {
-        auto iterator = m_components.find(std::type_index(typeid(T)));
-        if (iterator != m_components.end()) {
-            m_components.erase(iterator);
-            return true;//component removed
-        }
-        return false;//component not found
+        //false if component not found
+        return m_storage->removeComponent(*this, componentID<T>);
     }
 
 private:
+    friend class ArchetypeStorage;
+    friend class GameObjectManager;
+
     std::string m_name;//name of object
     std::string m_prefabID; // optional, empty if created without prefab
     bool autoMove;
 
-	// Map of components attached to the game object
-    std::unordered_map<std::type_index, std::unique_ptr<Component>> m_components;
+	// where the components of this object live
+    ArchetypeStorage* m_storage = nullptr;
+    Archetype* m_archetype = nullptr;
+    size_t m_row = 0;
+
+    EntityHandle m_handle; // slot in the owning GameObjectManager
     
     //default layer is 1
 	int m_layerID = 1;
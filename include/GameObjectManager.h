@@ -20,10 +20,17 @@ Technology is prohibited.
 
 #include "GameObject.h"
 #include "layerManager.h"
+#include "PoolAllocator.h"
+#include "EntityCommandBuffer.h"
+#include "ObjectPool.h"
+#include "TransformHierarchy.h"
 
 // This class is responsible for creating, storing, and providing access to game objects.
 class GameObjectManager {
 public:
+	GameObjectManager() = default;
+	~GameObjectManager();
+
 	//create objects
 	GameObject* createGameObject(const std::string& name);
 
@@ -33,20 +40,49 @@ public:
 	//use this when objects need to interact with each other
 	GameObject* getGameObject(const std::string& name);
 
-	// delete objects
+	//O(1) lookup, nullptr if the object behind the handle was deleted
+	GameObject* getGameObject(EntityHandle handle) const;
+	bool isAlive(EntityHandle handle) const;
+
+	//handle of a named object, null handle if there is none
+	EntityHandle getHandle(const std::string& name) const;
+
+	// delete objects, stale/null handles and pointers are ignored
 	void deleteGameObject(GameObject* object);
+	void deleteGameObject(EntityHandle handle);
 
 	//clone an existing object
 	GameObject* CloneGameObject(const std::string& sourceName, const std::string& newName);
 
-	//used for all the component systems
+	//every object, mainly for the editor/serialisation. systems should use view<>() instead
 	void getAllGameObjects(std::vector<GameObject*>& gameObjects);
 
+	//cached query of every object that has all of Ts, e.g. view<Transform, Physics>()
+	//stays up to date as components/objects are added and removed, so systems only touch what they need
+	template <typename... Ts>
+	View<Ts...> view() {
+		return m_storage.view<Ts...>();
+	}
+
+	//stream every object that has all of Ts, e.g. each<Transform, Physics>([](GameObject&, Transform&, Physics&) {})
+	//components are visited chunk by chunk so this is much cheaper than getAllGameObjects + getComponent
+	template <typename... Ts, typename Fn>
+	void each(Fn&& fn) {
+		m_storage.each<Ts...>(std::forward<Fn>(fn));
+	}
+
+	ArchetypeStorage& getStorage();
+
+	//structural changes made while systems are iterating go through here,
+	//CoreEngine plays them back at the sync points between systems
+	EntityCommandBuffer& getCommandBuffer() { return m_commands; }
+	void playbackCommands() { m_commands.playback(*this); }
+
 	// get the number of game objects
 	int getGameObjectCount();
 
-	//initialize game objects from a file
-	void init();
+	//initialize game objects from a scene file in the runtime scene folder
+	void init(const std::string& scene = "level01.json");
 
 	bool renameGameObject(GameObject* obj, const std::string& newName);
 
@@ -62,7 +98,15 @@ public:
 
 	void saveScene(const std::string& path, bool isNew = false) const;
 
-	void createBulletPool(const std::string& templateBulletName, int poolSize = 10);
+	//file name of the scene loadScene last loaded, e.g. "level01.json"
+	const std::string& getLoadedScene() const { return m_loadedScene; }
+
+	//prefab pools (bullets, vfx...), warmed up from the scene's "pools" array
+	ObjectPool& getPrefabPool() { return m_prefabPool; }
+
+	//parent/child links, saved as "parent" (the parent's name) on each child
+	TransformHierarchy& getHierarchy() { return m_hierarchy; }
+	const TransformHierarchy& getHierarchy() const { return m_hierarchy; }
 
 	//layering manager stuff
 	LayerManager& getLayerManager();
@@ -74,10 +118,43 @@ public:
 	void initializeSimulationResources();  
 	void cleanupSimulationResources();     
 
+	//pool usage, for the performance window
+	size_t getObjectPoolCapacity() const { return m_objectPool.getCapacity(); }
+
 	
 private:
-	//map of all game objects
-	std::unordered_map<std::string, std::unique_ptr<GameObject>> m_gameObjects;
+	// one per handle index, the generation goes up every time the slot is freed
+	struct ObjectSlot {
+		GameObject* object = nullptr; // lives in m_objectPool
+		std::uint32_t generation = 0;
+		std::uint32_t denseIndex = 0; // position in m_gameObjects while alive
+	};
+
+	// deletes every object in one go (scene switch), handles to them all go stale
+	void clearGameObjects();
+
+	//component storage, declared first so it outlives the objects using it
+	ArchetypeStorage m_storage;
+
+	//memory for the GameObjects themselves, kept across scene loads
+	PoolAllocator<GameObject> m_objectPool;
+
+	std::vector<ObjectSlot> m_slots;
+	std::vector<std::uint32_t> m_freeSlots;
+
+	//dense list of all live game objects, swap-removed on delete
+	std::vector<GameObject*> m_gameObjects;
+
+	//names are just a secondary index on top of the handles
+	std::unordered_map<std::string, EntityHandle> m_names;
 
 	LayerManager m_layerManager;
+
+	EntityCommandBuffer m_commands;
+
+	ObjectPool m_prefabPool;
+
+	TransformHierarchy m_hierarchy;
+
+	std::string m_loadedScene;
 };
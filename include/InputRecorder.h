@@ -0,0 +1,112 @@
+/* Start Header ************************************************************************/
+/*!
+\file		InputRecorder.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Records a played session (keyboard/mouse state, dt and fixed step count of
+            every frame) to a small binary file and plays it back through InputHandler.
+
+            Every recorded frame also carries a hash of the Transform/Physics state at
+            the end of that frame. Playback hashes the same state again and reports the
+            first frame where the two differ, so a tester's session either reproduces
+            exactly or says where it stopped doing so.
+
+            File layout (little endian, as written by the engine):
+              header  "RPLY", u32 version, f64 fixed dt, u16 scene name length, name
+              frame   f32 dt, u8 fixed steps, u16 key toggle count, u16 toggled keys...,
+                      u8 mouse buttons (bit per button), f32 mouse x, f32 mouse y,
+                      f32 scroll, u64 state hash
+            Keys are stored as the ones that changed since the previous frame, most
+            frames have none.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "input.h"
+
+class GameObjectManager;
+
+class InputRecorder {
+public:
+    enum class Mode {
+        Off,
+        Recording,
+        Replaying
+    };
+
+    // starts a new file, frames are added by beginFrame/endFrame. false if it can not be written
+    bool startRecording(const std::string& path, const std::string& scene, double fixedDt);
+
+    // reads the whole file up front. false if it is missing or not a recording
+    bool startReplay(const std::string& path);
+
+    // closes the file (recording) or prints the result (replay)
+    void stop();
+
+    Mode getMode() const { return m_mode; }
+    bool isActive() const { return m_mode != Mode::Off; }
+
+    // scene file name and fixed dt the session was recorded with
+    const std::string& getScene() const { return m_scene; }
+    double getFixedDt() const { return m_fixedDt; }
+
+    // call after InputHandler::update, before the frame runs.
+    // recording: saves this frame's input along with dt and simSteps.
+    // replay: puts the recorded input into InputHandler and replaces dt and simSteps,
+    // false once the recording is used up (replay stops by itself then)
+    bool beginFrame(float& dt, int& simSteps);
+
+    // call once the frame ran. recording: saves the hash, replay: compares against it
+    void endFrame(std::uint64_t stateHash);
+
+    size_t getFrame() const { return m_frame; }
+
+    // first frame (0 based) whose state hash did not match, -1 while everything matched
+    long long getFirstDivergence() const { return m_firstDivergence; }
+
+    // FNV-1a over every Transform and Physics in the scene, in storage order
+    static std::uint64_t hashState(GameObjectManager& manager);
+
+private:
+    struct Frame {
+        float dt;
+        std::uint8_t simSteps;
+        std::vector<std::uint16_t> toggledKeys;
+        std::uint8_t mouseButtons;
+        float mouseX, mouseY;
+        float scroll;
+        std::uint64_t hash;
+    };
+
+    bool readFrame(std::ifstream& in, Frame& frame) const;
+    void writeFrame(const Frame& frame);
+
+    static constexpr std::uint32_t VERSION = 1;
+
+    Mode m_mode = Mode::Off;
+    std::string m_path;
+    std::string m_scene;
+    double m_fixedDt = 1.0 / 60.0;
+
+    // key/mouse state as of the previous frame, toggles are relative to this
+    InputHandler::FrameInput m_input{};
+
+    std::ofstream m_out;
+    Frame m_pending{};          // recording: this frame, written once its hash is known
+
+    std::vector<Frame> m_frames; // replay: the whole file
+    size_t m_frame = 0;
+    long long m_firstDivergence = -1;
+};
@@ -0,0 +1,163 @@
+/* Start Header ************************************************************************/
+/*!
+\file		JobSystem.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Work stealing job system. Every thread (workers plus the main thread) has
+            its own deque: it pushes and pops its own jobs at the back, and when it
+            runs dry it steals from the front of someone else's. Waiting on jobs never
+            blocks a thread that could be doing work, it runs other jobs instead.
+
+            On top of that there is parallelFor for splitting a loop into slices and
+            TaskGraph for running jobs with dependencies between them (the
+            SystemScheduler builds one of those every frame).
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+// number of unfinished jobs submitted with it, wait() on it to join them
+struct JobCounter {
+    std::atomic<size_t> pending{ 0 };
+};
+
+// the part of a parallelFor one job gets. slices are contiguous and numbered in order,
+// so per slice scratch buffers merged by slice index come out in the same order as a
+// plain loop would have produced
+struct JobRange {
+    size_t slice;
+    size_t begin;
+    size_t end;
+};
+
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    static JobSystem& getInstance();
+
+    // starts the workers, negative = one per core minus the main thread, 0 = no workers
+    // (everything then runs on the calling thread). calling it again restarts the pool
+    void init(int workerCount = -1);
+
+    // finishes the queued jobs and joins the workers
+    void shutdown();
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+    // workers + the main thread, the size to give per thread arrays
+    unsigned getThreadSlotCount() const { return getWorkerCount() + 1; }
+
+    // 0 on the main (or any non worker) thread, 1..getWorkerCount() on the workers
+    static unsigned getThreadSlot();
+
+    // jobs must not throw. counter (if any) is raised now and lowered once the job ran
+    void submit(Job job, JobCounter* counter = nullptr);
+
+    // runs other jobs until every job submitted with counter is done
+    void wait(const JobCounter& counter);
+
+    // runs one queued job (own deque first, then steals), false if there was none
+    bool tryRunOne();
+
+    // how many slices parallelFor(count, minGrain, ...) will use, to size scratch buffers
+    size_t getSliceCount(size_t count, size_t minGrain) const;
+
+    // calls fn once per slice of [0, count) and returns when all of them are done.
+    // a slice is at least minGrain items, a single slice runs inline on the caller
+    void parallelFor(size_t count, size_t minGrain, const std::function<void(const JobRange&)>& fn);
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+
+    struct QueuedJob {
+        Job job;
+        JobCounter* counter;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    void workerLoop(unsigned slot);
+    bool popOrSteal(unsigned slot, QueuedJob& out);
+    static void runJob(QueuedJob& queued);
+
+    // slices per thread, a few extra so stealing can even out uneven slices
+    static constexpr size_t SLICES_PER_THREAD = 4;
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues; // one per thread slot
+    std::vector<std::thread> m_threads;
+
+    std::atomic<size_t> m_queued{ 0 };
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+};
+
+// Jobs with dependencies, run once per run() call. Main thread tasks run on the thread
+// calling run(), in the order they were added, everything else goes to the job system.
+class TaskGraph {
+public:
+    using Task = std::function<void()>;
+
+    size_t addTask(const std::string& name, Task task, bool mainThread = false);
+
+    // after does not start before before has finished, before must be added first
+    void addDependency(size_t before, size_t after);
+
+    // blocks until every task ran. the calling thread runs the main thread tasks and
+    // helps with the others in between. the first exception thrown by a task is
+    // rethrown here, the tasks that had not started yet are skipped
+    void run(JobSystem& jobs);
+
+    size_t size() const { return m_nodes.size(); }
+    const std::string& getName(size_t task) const { return m_nodes[task].name; }
+    const std::vector<size_t>& getDependencies(size_t task) const { return m_nodes[task].dependencies; }
+    bool isMainThread(size_t task) const { return m_nodes[task].mainThread; }
+
+private:
+    struct Node {
+        std::string name;
+        Task task;
+        bool mainThread;
+        std::vector<size_t> dependencies;
+        std::vector<size_t> dependents;
+    };
+
+    // both called with m_mutex held
+    void dispatch(size_t task);
+    void finish(size_t task);
+
+    void execute(size_t task);
+
+    std::vector<Node> m_nodes;
+
+    // per run state
+    JobSystem* m_jobs = nullptr;
+    std::mutex m_mutex;
+    std::condition_variable m_mainWake;
+    std::vector<size_t> m_waitingOn;   // unfinished dependencies per task
+    std::vector<size_t> m_mainReady;   // main thread tasks that can start
+    size_t m_remaining = 0;
+    std::exception_ptr m_error;
+};
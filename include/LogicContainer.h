@@ -21,6 +21,7 @@ Technology is prohibited.
 
 class GameObject;
 class GameObjectManager;
+class EntityCommandBuffer;
 
 #include "Component.h"
 #include "input.h"
@@ -47,10 +48,10 @@ public:
      *
      * \param obj      Reference to the GameObject whose logic is being updated.
      * \param dt       Delta time for the current frame.
-     * \param manager  Reference to the GameObjectManager used for spawning
-     *                 or retrieving other objects (e.g., bullets).
+     * \param commands Deferred structural changes, e.g. an AudioComponent added on
+     *                 the first state change. Played back after the logic system.
      */
-    void update(GameObject& obj, float dt /*, GameObjectManager& manager */);
+    void update(GameObject& obj, float dt, EntityCommandBuffer& commands);
 
 private:
 
@@ -62,8 +63,18 @@ private:
      *
      * \param obj   The object to transition.
      * \param next  The PlayerState to move into.
+     * \param commands Where the AudioComponent is queued if the object has none yet.
      */
-    static void enter(GameObject& obj, PlayerState next);
+    static void enter(GameObject& obj, PlayerState next, EntityCommandBuffer& commands);
+
+    /*!
+     * \brief Plays the sounds that go with leaving one state and entering another.
+     *
+     * \param audio The AudioComponent of the object changing state.
+     * \param prev  The PlayerState being left.
+     * \param next  The PlayerState being entered.
+     */
+    static void playTransitionAudio(AudioComponent& audio, PlayerState prev, PlayerState next);
 
     /*!
      * \brief Behavior function executed when the object is in Idle state.
@@ -73,8 +84,9 @@ private:
      *
      * \param obj The object in Idle state.
      * \param dt  Time elapsed for the frame.
+     * \param commands Deferred structural changes, passed on to enter().
      */
-    static void tickIdle(GameObject& obj, float dt);
+    static void tickIdle(GameObject& obj, float dt, EntityCommandBuffer& commands);
 
     /*!
      * \brief Behavior function executed when the object is in Walking state.
@@ -84,8 +96,9 @@ private:
      *
      * \param obj The object in Walking state.
      * \param dt  Time elapsed for the frame.
+     * \param commands Deferred structural changes, passed on to enter().
      */
-    static void tickWalking(GameObject& obj, float dt);
+    static void tickWalking(GameObject& obj, float dt, EntityCommandBuffer& commands);
 
     /*!
      * \brief Behavior function executed when the object is in Jumping state.
@@ -95,8 +108,9 @@ private:
      *
      * \param obj The object in Jumping state.
      * \param dt  Time elapsed for the frame.
+     * \param commands Deferred structural changes, passed on to enter().
      */
-    static void tickJumping(GameObject& obj, float dt);
+    static void tickJumping(GameObject& obj, float dt, EntityCommandBuffer& commands);
 
     /*!
      * \brief Behavior function executed when the object is in Falling state.
@@ -106,8 +120,9 @@ private:
      *
      * \param obj The object in Falling state.
      * \param dt  Time elapsed for the frame.
+     * \param commands Deferred structural changes, passed on to enter().
      */
-    static void tickFalling(GameObject& obj, float dt);
+    static void tickFalling(GameObject& obj, float dt, EntityCommandBuffer& commands);
 
     /*!
      * \brief Spawns a bullet near the object and initializes its velocity.
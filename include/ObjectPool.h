@@ -0,0 +1,96 @@
+/* Start Header ************************************************************************/
+/*!
+\file		ObjectPool.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Pools of ready made prefab instances (bullets, vfx, particles). The scene
+            file says how many of each prefab to create up front, after that acquire
+            hands out a free one and release puts it back, both O(1) with no object
+            creation and no searching by name.
+
+            Pooled objects stay in the scene the whole time, a free one is just hidden
+            (Render::visible) and not alive (Physics::alive). Starting an acquired
+            object (e.g. firing a bullet) is up to whoever acquired it.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#include "EntityHandle.h"
+#include "GameObject.h"
+
+class GameObjectManager;
+
+class ObjectPool {
+public:
+    ObjectPool() = default;
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // instantiates prefabs until the pool of prefabID holds count objects, all free.
+    // creates objects, so only call it outside system iteration (scene load, sync points)
+    bool warmUp(GameObjectManager& manager, const std::string& prefabID, size_t count);
+
+    // a free object of prefabID marked in use, made visible and colliding again if its prefab
+    // collides, nullptr if the pool is
+    // empty or does not exist. pools never grow here, so it is safe while iterating.
+    // systems calling this or release declare EngineResource::ObjectPools
+    GameObject* acquire(GameObjectManager& manager, const std::string& prefabID);
+
+    // hides the object and returns it to its pool, false if it is not pooled or already free
+    bool release(GameObjectManager& manager, EntityHandle handle);
+
+    bool isPooled(EntityHandle handle) const { return m_members.count(handle) != 0; }
+
+    // objects currently handed out, in no particular order
+    const std::vector<EntityHandle>& getActive() const { return m_active; }
+
+    // pool lookup by the prefab's name (e.g. "bullet"), empty string if there is no such pool
+    const std::string& findPrefabID(const std::string& prefabName) const;
+
+    size_t getSize(const std::string& prefabID) const;
+    size_t getFreeCount(const std::string& prefabID) const;
+
+    // every pool as prefab id -> size, for saving the scene
+    std::vector<std::pair<std::string, size_t>> getPoolSizes() const;
+
+    // called by the manager when a pooled object gets deleted some other way
+    void forget(EntityHandle handle);
+
+    // drops every pool without touching the objects (scene switch, they are deleted anyway)
+    void clear();
+
+private:
+    struct Pool {
+        std::string prefabName;
+        std::vector<EntityHandle> free; // free list, acquire/release at the back
+        size_t size = 0;
+        size_t nextNumber = 0;          // for naming new instances
+    };
+
+    struct Member {
+        Pool* pool;        // map nodes do not move, so this stays valid
+        size_t activeIndex; // position in m_active, NOT_ACTIVE while free
+        bool collides;      // the prefab's CollisionInfo::collisionFlag, off while free
+    };
+
+    static constexpr size_t NOT_ACTIVE = static_cast<size_t>(-1);
+
+    // hides the object, stops its physics and takes it out of collision
+    static void park(GameObject& object);
+
+    std::unordered_map<std::string, Pool> m_pools; // keyed by prefab id
+    std::unordered_map<EntityHandle, Member, EntityHandleHash> m_members;
+    std::vector<EntityHandle> m_active;
+};
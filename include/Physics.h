@@ -55,9 +55,9 @@ struct PhysicsForces {
 
     /*static void applyDynamics(Physics* physics, float deltaTime);*/
     /**
-     * @brief Finds an available/free bullet from the object pool
+     * @brief Takes a free bullet from the "bullet" prefab pool, nullptr if they are all in flight
      */
-    static GameObject* findAvailableBullet(GameObjectManager& manager);
+    static GameObject* acquireBullet(GameObjectManager& manager);
     /**
      * @brief Deactivates a bullet and returns it to the object pool
      */
@@ -0,0 +1,109 @@
+/* Start Header ************************************************************************/
+/*!
+\file		PoolAllocator.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Fixed size pool for one type. Memory is grabbed from the heap in blocks of
+            BLOCK_COUNT objects and handed out from a free list, so creating and
+            destroying objects of that type does not touch the heap once the pool
+            has grown to the size the scene needs. Blocks are only given back in
+            release() (or the destructor), not when objects are destroyed.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <new>
+#include <cstddef>
+
+template <typename T, size_t BLOCK_COUNT = 256>
+class PoolAllocator {
+public:
+    PoolAllocator() = default;
+    ~PoolAllocator() { release(); }
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    template <typename... TArgs>
+    T* create(TArgs&&... args) {
+        void* memory = allocate();
+        return ::new (memory) T(std::forward<TArgs>(args)...);
+    }
+
+    void destroy(T* ptr) {
+        if (!ptr) return;
+        ptr->~T();
+        deallocate(ptr);
+    }
+
+    // raw memory for one T
+    void* allocate() {
+        if (!m_free) grow();
+
+        Slot* slot = m_free;
+        m_free = slot->next;
+        ++m_live;
+        return slot->storage;
+    }
+
+    void deallocate(void* ptr) {
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        slot->next = m_free;
+        m_free = slot;
+        --m_live;
+    }
+
+    // marks every slot free in one go, keeping the blocks for the next scene.
+    // every object must already have been destroyed (destructors are not run here)
+    void reset() {
+        m_free = nullptr;
+        for (std::unique_ptr<Slot[]>& block : m_blocks) {
+            for (size_t i = BLOCK_COUNT; i-- > 0;) {
+                block[i].next = m_free;
+                m_free = &block[i];
+            }
+        }
+        m_live = 0;
+    }
+
+    // gives every block back to the heap, same rule as reset()
+    void release() {
+        m_blocks.clear();
+        m_free = nullptr;
+        m_live = 0;
+    }
+
+    size_t getLiveCount() const { return m_live; }
+    size_t getCapacity() const { return m_blocks.size() * BLOCK_COUNT; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    void grow() {
+        m_blocks.push_back(std::make_unique<Slot[]>(BLOCK_COUNT));
+        Slot* block = m_blocks.back().get();
+
+        // link the new block in order so objects are handed out front to back
+        for (size_t i = BLOCK_COUNT; i-- > 0;) {
+            block[i].next = m_free;
+            m_free = &block[i];
+        }
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> m_blocks;
+    Slot* m_free = nullptr;
+    size_t m_live = 0;
+};
@@ -0,0 +1,70 @@
+/* Start Header ************************************************************************/
+/*!
+\file		RadixSort.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 16th, 2026
+\brief      Stable LSD radix sort on a 64 bit key, for sorting the render queue every
+            frame without comparisons.
+
+            Entries are anything with a std::uint64_t key member, kept small (key plus
+            an index) since every pass moves all of them. The eight byte histograms are
+            counted in one go first, and a pass whose byte is the same in every key
+            (unused key bits, one layer only, ...) is skipped, so a queue with few
+            distinct keys sorts in two or three passes instead of eight.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// sorts entries by key, equal keys keep their order. scratch is resized as needed and
+// holds nothing useful afterwards, keep it around to not allocate every frame
+template <typename Entry>
+void radixSort64(std::vector<Entry>& entries, std::vector<Entry>& scratch)
+{
+    const size_t count = entries.size();
+    if (count < 2) return;
+    scratch.resize(count);
+
+    std::array<std::array<size_t, 256>, 8> histograms{};
+    for (const Entry& entry : entries) {
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    Entry* from = entries.data();
+    Entry* to = scratch.data();
+    for (int pass = 0; pass < 8; ++pass) {
+        std::array<size_t, 256>& histogram = histograms[pass];
+
+        // every key has the same byte here, the order would not change
+        if (histogram[(from[0].key >> (pass * 8)) & 0xFF] == count) continue;
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            to[histogram[(from[i].key >> (pass * 8)) & 0xFF]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+
+    // an odd number of passes left the result in scratch
+    if (from != entries.data()) entries.swap(scratch);
+}
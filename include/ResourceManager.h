@@ -20,6 +20,7 @@ Technology is prohibited.
 #include <string>
 #include <unordered_map>
 #include <map>
+#include <vector>
 #include <filesystem>
 #include <iostream>
 #include <ft2build.h>
@@ -32,13 +33,27 @@ Technology is prohibited.
 #include "AudioUtility.h"
 #include "fontTypes.h"
 
+// id is a plain GL_TEXTURE_2D (a view of one layer, for ImGui and anything else that
+// wants a single texture). the renderer draws from array/layer instead, so sprites that
+// share an array share a draw call
 struct TextureData {
     GLuint id = 0;
     bool isTransparent = false;
+    GLuint array = 0;
+    GLuint layer = 0;
 };
 
+// where a TextureData::id lives in the texture arrays
+struct TextureLayer {
+    GLuint array = 0;
+    GLuint layer = 0;
+};
+
+// every glyph of a font is packed into one GL_R8 atlas, so text in that font draws
+// with one texture bound
 struct FontData {
     FT_Face face = nullptr;
+    GLuint atlas = 0;
 	std::map<unsigned char, FontCharacter> characters;
 	bool isLoaded = false;
 };
@@ -68,6 +83,32 @@ public:
      */
     TextureData getTexture(const std::string& path);
 
+    /**
+     * @brief Looks a texture up without loading it, safe to call from worker threads
+     *        as long as nothing is loading at the same time.
+     * @param path The filepath to the texture.
+     * @return The cached texture, nullptr if it has not been loaded yet.
+     */
+    const TextureData* findTexture(const std::string& path) const;
+
+    /**
+     * @brief Finds the array texture and layer behind a texture id from getTexture, same
+     *        thread rules as findTexture.
+     * @param texture TextureData::id, e.g. Render::texHDL.
+     * @return {0, 0} if the id did not come from getTexture.
+     */
+    TextureLayer findTextureLayer(GLuint texture) const {
+        return texture < m_textureLayers.size() ? m_textureLayers[texture] : TextureLayer{};
+    }
+
+    /**
+     * @brief Records where a texture id lives for findTextureLayer. getTexture does this
+     *        for what it loads, the job benchmark for its made up ids.
+     * @param texture The texture id.
+     * @param layer Its array texture and layer, {0, 0} to forget it.
+     */
+    void setTextureLayer(GLuint texture, TextureLayer layer);
+
     /**
      * @brief Gets a sound. Loads it from file if not in cache.
      * @param path The filepath to the sound.
@@ -84,6 +125,16 @@ public:
      */
     GLuint getShader(const std::string& vertPath, const std::string& fragPath);
 
+    /**
+     * @brief Gets a uniform's location in a program from getShader. Every active uniform
+     *        is looked up once when the program loads, so this never asks the driver.
+     *        Callers that set a uniform every frame should still keep the result.
+     * @param program A program returned by getShader.
+     * @param name The uniform's name, arrays by name alone ("uTex2d", not "uTex2d[0]").
+     * @return The location, -1 if the program has no such uniform (or it was optimized out).
+     */
+    GLint getUniformLocation(GLuint program, const std::string& name) const;
+
     const FontData& getFont(const std::string& relativePath);
 
     std::vector<std::string> getLoadedFontPaths() const;
@@ -104,6 +155,16 @@ private:
     FontData loadFontFromFile(const std::string& path);
     FMOD::Sound* loadSoundFromFile(const std::string& path, bool loop);
 
+    // finds room for a width x height image, making a new array if every one of that size is full
+    TextureLayer allocateTextureLayer(int width, int height);
+
+    // counts the images under assets/ by size, once, so each array is made big enough
+    // for every image of its size the first time one of them loads
+    void scanTextureSizes();
+
+    // fills m_uniformLocations for a freshly linked program
+    void cacheUniformLocations(GLuint program);
+
     // FMOD system instance (required for sound creation)
     FMOD::System* m_fmodSystem = nullptr;
     FT_Library m_ftLibrary = nullptr;
@@ -112,7 +173,24 @@ private:
     std::unordered_map<std::string, TextureData> m_textureCache;
     std::unordered_map<std::string, FMOD::Sound*> m_audioCache;
     std::unordered_map<std::string, GLuint> m_shaderCache;
+    std::unordered_map<GLuint, std::unordered_map<std::string, GLint>> m_uniformLocations; // by program
     std::unordered_map<std::string, FontData> m_fontCache;
 
+    // GL_TEXTURE_2D_ARRAYs, one or more per image size. layers are never given back,
+    // textures stay loaded until shutdown
+    struct TextureArray {
+        GLuint id = 0;
+        int width = 0;
+        int height = 0;
+        GLsizei layers = 0;
+        GLsizei used = 0;
+    };
+    std::vector<TextureArray> m_textureArrays;
+    std::map<std::pair<int, int>, GLsizei> m_textureSizeCounts;
+    bool m_textureSizesScanned = false;
+
+    // indexed by TextureData::id
+    std::vector<TextureLayer> m_textureLayers;
+
 
 };
@@ -0,0 +1,101 @@
+/* Start Header ************************************************************************/
+/*!
+\file		SpatialGrid.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 16th, 2026
+\brief      Uniform grid of object bounds, for asking "what is inside this rect" without
+            going over every object. Render uses it to cull against the camera.
+
+            Cells are made on demand (hashed by cell coordinate), so a level can be as
+            wide as it likes. An object sits in every cell its bounds touch. Objects
+            bigger than MAX_CELLS_PER_OBJECT cells (backgrounds) are kept in one list
+            that every query checks instead, so they do not fill hundreds of cells.
+
+            Entries are stored by handle index. The stamp passed to insert is whatever
+            the caller uses to tell that an object moved (Render passes the Transform
+            version), isCurrent compares against it. Nothing here looks at the objects
+            themselves, stale handles are dropped by the caller with remove.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "EntityHandle.h"
+
+class SpatialGrid {
+public:
+    struct Rect {
+        float minX, minY, maxX, maxY;
+
+        bool overlaps(const Rect& other) const {
+            return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+        }
+    };
+
+    explicit SpatialGrid(float cellSize = 8.f) : m_cellSize(cellSize) {}
+
+    // adds the object, or moves it if it is in already (an old handle with the same index is replaced)
+    void insert(EntityHandle handle, const Rect& bounds, std::uint32_t stamp);
+    void remove(EntityHandle handle);
+
+    // in the grid with this stamp. only reads, fine from several threads while nothing inserts
+    bool isCurrent(EntityHandle handle, std::uint32_t stamp) const {
+        if (handle.index >= m_entries.size()) return false;
+        const Entry& entry = m_entries[handle.index];
+        return entry.inGrid && entry.handle == handle && entry.stamp == stamp;
+    }
+
+    // appends every object whose bounds overlap area, each once, in no particular order
+    void query(const Rect& area, std::vector<EntityHandle>& out);
+
+    void clear();
+
+    size_t getCount() const { return m_count; }
+    size_t getCellCount() const { return m_cells.size(); }
+
+    static constexpr int MAX_CELLS_PER_OBJECT = 64;
+
+private:
+    struct CellKey {
+        int x;
+        int y;
+
+        bool operator==(const CellKey& other) const { return x == other.x && y == other.y; }
+    };
+
+    struct CellKeyHash {
+        size_t operator()(const CellKey& key) const noexcept {
+            return std::hash<std::uint64_t>{}((static_cast<std::uint64_t>(static_cast<std::uint32_t>(key.x)) << 32) | static_cast<std::uint32_t>(key.y));
+        }
+    };
+
+    struct Entry {
+        EntityHandle handle;
+        Rect bounds{};
+        int cellMinX = 0, cellMinY = 0, cellMaxX = 0, cellMaxY = 0;
+        std::uint32_t stamp = 0;
+        std::uint32_t queryMark = 0;   // last query that returned it
+        bool inGrid = false;
+        bool oversized = false;
+    };
+
+    int cellOf(float value) const;
+    void unlink(std::uint32_t index);
+
+    float m_cellSize;
+    std::vector<Entry> m_entries;                                            // by handle index
+    std::unordered_map<CellKey, std::vector<std::uint32_t>, CellKeyHash> m_cells; // entry indices
+    std::vector<std::uint32_t> m_oversized;
+    std::uint32_t m_queryMark = 0;
+    size_t m_count = 0;
+};
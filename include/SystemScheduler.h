@@ -0,0 +1,115 @@
+/* Start Header ************************************************************************/
+/*!
+\file		SystemScheduler.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Runs the per frame systems as a dependency graph instead of one after the
+            other. Every system declares the components (and shared engine state) it
+            reads and writes. A system waits for every earlier system it conflicts
+            with, anything independent runs at the same time on the JobSystem.
+            Systems that touch GL, ImGui or Lua are marked SystemThread::Main and
+            always run on the thread calling run(), in the order they were added.
+
+            In CoreEngine's graph the last fixed step's systems are nodes of their
+            own (World::registerSimulation): TileMap only reads transforms, so it
+            runs on the main thread while Logic runs on a worker, and Audio runs on
+            a worker next to Render and Font. The Commands sync points and the
+            catch-up steps of a slow frame still conflict with everything.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <bitset>
+#include <functional>
+
+#include "Component.h" // makeSignature
+#include "JobSystem.h"
+
+// shared state outside the components that systems also fight over
+enum class EngineResource : std::uint8_t {
+    MessageBus,     // publishing calls the subscribers right away
+    EditorState,    // editing/paused flags, UI toggle
+    CommandBuffer,  // the manager's EntityCommandBuffer
+    TileBatches,    // RenderSystem::visibleTileBatches
+    Audio,          // AudioHandler / FMOD channels
+    ObjectPools,    // the manager's prefab ObjectPool (acquire/release)
+    Hierarchy,      // the manager's TransformHierarchy (parent links, depth first order)
+    StepInput,      // InputHandler's per step key state, moved on at the end of each step
+    Count
+};
+
+using ResourceSet = std::bitset<static_cast<size_t>(EngineResource::Count)>;
+
+// what one system touches, e.g. SystemAccess().read<Input>().write<Transform, Physics>()
+struct SystemAccess {
+    ComponentSignature reads;
+    ComponentSignature writes;
+    ResourceSet resourceReads;
+    ResourceSet resourceWrites;
+
+    template <typename... Ts>
+    SystemAccess& read() { reads |= makeSignature<Ts...>(); return *this; }
+
+    template <typename... Ts>
+    SystemAccess& write() { writes |= makeSignature<Ts...>(); return *this; }
+
+    SystemAccess& read(EngineResource resource) { resourceReads.set(static_cast<size_t>(resource)); return *this; }
+    SystemAccess& write(EngineResource resource) { resourceWrites.set(static_cast<size_t>(resource)); return *this; }
+
+    // structural changes (command buffer playback) conflict with everything
+    SystemAccess& writeAll() { writes.set(); resourceWrites.set(); return *this; }
+
+    // true if the two can not safely run at the same time
+    bool conflictsWith(const SystemAccess& other) const {
+        return (writes & (other.reads | other.writes)).any() || (other.writes & reads).any()
+            || (resourceWrites & (other.resourceReads | other.resourceWrites)).any()
+            || (other.resourceWrites & resourceReads).any();
+    }
+};
+
+enum class SystemThread {
+    Main,   // GL, ImGui, Lua, GLFW
+    Any
+};
+
+class SystemScheduler {
+public:
+    using SystemFn = std::function<void(float)>;
+
+    SystemScheduler() = default;
+
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    // order matters, a system only ever waits on systems added before it
+    void addSystem(const std::string& name, const SystemAccess& access, SystemThread thread, SystemFn fn);
+
+    // runs every system once on the JobSystem and returns when all are done.
+    // an exception thrown by any system is rethrown here after the rest have stopped
+    void run(float deltaTime);
+
+    // graph inspection, CoreEngine logs it once after registering everything
+    size_t getSystemCount() const { return m_graph.size(); }
+    const std::string& getSystemName(size_t index) const { return m_graph.getName(index); }
+    const std::vector<size_t>& getDependencies(size_t index) const { return m_graph.getDependencies(index); }
+    bool isMainThread(size_t index) const { return m_graph.isMainThread(index); }
+
+private:
+    struct SystemEntry {
+        SystemAccess access;
+        SystemThread thread;
+    };
+
+    std::vector<SystemEntry> m_systems;
+    TaskGraph m_graph;
+    float m_deltaTime = 0.0f;
+};
@@ -31,6 +31,9 @@ Technology is prohibited.
 #include "controllerSystem.h"
 #include <LogicContainer.h>
 #include "audio.h"
+#include "JobSystem.h"
+#include "SpatialGrid.h"
+#include "RadixSort.h"
 
 //forward declaration
 struct renderer;
@@ -51,6 +54,14 @@ public:
 private:
 	bool m_stepMode = false;
 	bool m_stepReq = false;
+
+	struct PooledBody {
+		GameObject* object;
+		Transform* transform;
+		Physics* physics;
+	};
+	std::vector<PooledBody> m_pooledBodies; // alive pooled objects, reused every frame for the parallel pass
+	std::vector<GameObject*> m_wasOnGround;  // on the ground before this step, only the player asks (to jump)
 };
 
 /*!***********************************************************************
@@ -88,8 +99,6 @@ public:
 	void update(GameObjectManager& manager, float const& deltaTime);
 	//moved to ResourceManager
 	//GLuint uploadtex(std::string const& filename, bool& isTransparent);
-	void renderTex(GameObject* object, float const& deltaTime);
-	void renderNoTex(GameObject* object);
 	void renderFBO();
 	void resizeFBO(int width, int height);
 	GLuint getTexture() const { return texture; }
@@ -97,15 +106,166 @@ public:
 	//not implemented yet, hopefully tri break can do
 	//void renderCollision(Collision::AABB const& box, glm::vec3 const& clr);
 	//GLuint getTexture() const { return texture; }
-	void batchingSetUp(GameObjectManager& manager, float const& deltaTime);
+	/*!***********************************************************************
+	\brief
+		batches the Render objects inside viewRect. the spatial grid is brought
+		up to date first (only objects whose Transform changed are reinserted),
+		then only what the grid returns for viewRect is batched
+
+	*************************************************************************/
+	void batchingSetUp(GameObjectManager& manager, float const& deltaTime, const SpatialGrid::Rect& viewRect);
+
+	/*!***********************************************************************
+	\brief
+		the camera drawn with this frame: the editor camera while editing with
+		the UI up, the game camera otherwise
+
+	*************************************************************************/
+	static renderer::camera& activeCamera();
+
+	/*!***********************************************************************
+	\brief
+		world rect a camera sees, the same bounds as its ortho projection
+
+	*************************************************************************/
+	static SpatialGrid::Rect viewRect(const renderer::camera& cam);
+
+	/*!***********************************************************************
+	\brief
+		last frame's culling for the performance window, the tile counts are
+		filled in by TileMapSystem. hidden objects are not counted
+
+	*************************************************************************/
+	struct CullStats {
+		size_t objectsVisible = 0;
+		size_t objectsCulled = 0;
+		size_t objectsReindexed = 0; //moved, so put back in the grid this frame
+		size_t tilesVisible = 0;
+		size_t tilesCulled = 0;
+	};
+	static CullStats cullStats;
+
+	/*!***********************************************************************
+	\brief
+		last frame's render queue for the performance window. runs are the
+		draws the sorted queue was cut into, each one draw command
+
+	*************************************************************************/
+	struct QueueStats {
+		size_t items = 0;           //objects plus static batches
+		size_t runs = 0;
+		size_t programSwitches = 0;
+		size_t layers = 0;          //layers that had something to draw
+	};
+	static QueueStats queueStats;
+
+	/*!***********************************************************************
+	\brief
+		a static batch to draw this frame, sorted into the render queue as
+		one item at depth z in its object's layer
+
+	*************************************************************************/
+	struct StaticDraw {
+		const renderer::StaticBatch* batch;
+		int layer;
+		float z;
+	};
 
 	void fboAspectRatio(int& width, int& height) const;
+
+	//0 = where objects were at the start of the last fixed step, 1 = where they are now
+	void setInterpolationAlpha(float alpha) { interpolationAlpha = alpha; }
 	~RenderSystem();
 	//bool batchRebuild = true;
-	static std::unordered_map<BatchKey, std::vector<renderer::InstanceData>, BatchKeyHash> objectWithTex2;
+
+	//the tile map chunks in view this frame, filled by TileMapSystem::update.
+	//TileMapSystem owns the batches
+	static std::vector<StaticDraw> visibleTileBatches;
 private:
-	std::unordered_map<BatchKey, std::vector<renderer::InstanceData>, BatchKeyHash> objectWithTex;
-	std::unordered_map<shape, std::vector<renderer::InstanceData>> objectWithoutTex;
+	/*!***********************************************************************
+	\brief
+		moves every visible animated object's current state on to its next
+		frame when its frame time is up, culled or not. called by
+		batchingSetUp once the frames have been read for drawing
+
+	*************************************************************************/
+	void stepAnimations(GameObjectManager& manager, float deltaTime);
+
+	/*!***********************************************************************
+	\brief
+		rebuilds staticGroups from staticObjects, called by batchingSetUp
+		when one of them was edited, added or removed
+
+	*************************************************************************/
+	void buildStaticObjects(GameObjectManager& manager);
+
+	/*!***********************************************************************
+	\brief
+		draws the sorted queue: layer by layer, opaque then transparent, and
+		cuts it into runs of the same mesh and texture for the draw list.
+		the program only changes where the sort order makes it. all layers
+		share the depth buffer, see makeSortKey
+
+	*************************************************************************/
+	void drawQueue();
+
+	//the render queue. every object in view is one item, sortEntries is sorted by
+	//key every frame (see makeSortKey in Systems.cpp) and drawn in that order.
+	//an index past queueItems is a static batch in queueStatics
+	struct QueueItem {
+		std::uint64_t key;
+		BatchKey batch;             //texID 0 = no texture, noTex program
+		renderer::InstanceData data;
+	};
+	struct SortEntry {
+		std::uint64_t key;
+		std::uint32_t index;
+	};
+	std::vector<Layer*> layers; //refilled every frame
+	std::vector<QueueItem> queueItems;
+	std::vector<StaticDraw> queueStatics;
+	std::vector<SortEntry> sortEntries;
+	std::vector<SortEntry> sortScratch;
+	std::vector<renderer::InstanceData> runInstances;
+
+	//batchingSetUp runs as a parallelFor, each slice batches into its own scratch
+	//and the slices are merged into queueItems in order afterwards
+	struct GridUpdate {
+		EntityHandle handle;
+		SpatialGrid::Rect bounds;
+		std::uint32_t version;
+	};
+	struct BatchScratch {
+		std::vector<QueueItem> items;
+		std::vector<GridUpdate> moved;   //objects to reinsert into the grid
+		std::vector<EntityHandle> stale; //in the grid but gone (or lost Render)
+		std::vector<EntityHandle> statics; //drawn from staticGroups instead
+		std::uint64_t staticHash = 0;    //of what the statics look like, see batchingSetUp
+		size_t shown = 0;                //objects with Render::visible set
+		size_t drawn = 0;                //of those, the ones batched
+	};
+	std::vector<BatchScratch> batchScratch;
+	std::vector<ArchetypeChunk> batchChunks;
+
+	//every Render object's bounds, so batching only visits what the camera can see
+	SpatialGrid objectGrid;
+	std::vector<EntityHandle> visibleObjects;
+
+	//Render::isStatic objects, one batch per layer and z that stays on the GPU. the hash and
+	//count are of what they were built from, a different sum next frame means something
+	//was edited
+	struct StaticGroup {
+		int layer = 0;
+		float z = 0.f;              //of all its objects, where it sorts
+		SpatialGrid::Rect bounds{};
+		renderer::StaticBatch batch;
+	};
+	std::vector<StaticGroup> staticGroups;
+	std::vector<EntityHandle> staticObjects;
+	std::uint64_t staticObjectHash = 0;
+	size_t staticObjectCount = 0;
+
+	float interpolationAlpha = 1.f;
 };
 
 /*!***********************************************************************
@@ -116,9 +276,13 @@ private:
 class TileMapSystem
 {
 public:
+	~TileMapSystem();
+
 	/*!***********************************************************************
 	\brief
-		update cycle to push the data in tiles to objectWithTex2 to be rendered in render system
+		update cycle to hand the tile chunks in view to the render system.
+		a chunk's static batch is only rebuilt when one of its tiles was
+		painted or cleared, or the tile map itself was edited
 
 	\param[in] manager
 		array of all objects
@@ -144,16 +308,81 @@ public:
 
 	*************************************************************************/
 	static std::string filename;
+
+	//a tile map is split into square chunks of this many tiles a side, each its own
+	//static batch, so painting a tile rebuilds one chunk and chunks out of view are skipped
+	static constexpr int CHUNK_TILES = 32;
+
+private:
+	struct TileChunk {
+		renderer::StaticBatch batch;
+		SpatialGrid::Rect bounds{};
+		size_t tileCount = 0;
+		bool dirty = true;
+	};
+
+	//one per tile map, what its chunks were built from
+	struct TileMapBatches {
+		EntityHandle handle;
+		std::uint32_t revision = 0;   //TileMap::revision
+		float x = 0.f, y = 0.f, z = 0.f;
+		float tileW = 0.f, tileH = 0.f;
+		std::unordered_map<TileMap::TileKey, TileChunk, TileMap::TileKeyHash> chunks; //by chunk coordinate
+		std::uint32_t seenFrame = 0;  //maps not seen in a frame are gone
+		bool built = false;
+	};
+
+	/*!***********************************************************************
+	\brief
+		brings the chunks of one tile map up to date: everything when the map
+		moved, was resized or changed without tileUpdate knowing (loading,
+		undo), otherwise only the chunks tileUpdate marked
+
+	*************************************************************************/
+	void updateChunks(TileMapBatches& batches, const TileMap& tileMap, const Transform& transform);
+
+	/*!***********************************************************************
+	\brief
+		rebuilds one chunk's static batch from the tiles inside it
+
+	*************************************************************************/
+	void buildChunk(TileMapBatches& batches, const TileMap::TileKey& chunkKey, TileChunk& chunk, const TileMap& tileMap);
+
+	static TileMap::TileKey chunkOf(int x, int y);
+
+	std::unordered_map<std::uint32_t, TileMapBatches> m_maps; //by handle index
+	std::uint32_t m_frame = 0;
 };
 
 class FontSystem {
 public:
-	void init(GameObjectManager& manager);
+	void init();
 	void update(GameObjectManager& manager, double fps);
-	void RenderText(GLuint& s, std::string text, float x, float y, float scale, glm::vec3 color, GameObject* object);
+
+	// queues the glyphs of text in a FontComponent::fontType font, update draws everything queued at the end
+	void RenderText(const std::string& text, float x, float y, float scale, glm::vec3 color, int fontType);
 
 	// sorry very scuffed but can remove aft submission
 	static inline bool showFPS = false;
+
+	struct TextStats {
+		size_t glyphs = 0;
+		size_t drawCalls = 0; // one per font atlas in use
+	};
+	static inline TextStats textStats;
+
+private:
+	// uploads every queued glyph in one go and draws each atlas's with one instanced draw
+	void drawGlyphs();
+
+	// this frame's glyphs by font atlas. kept from frame to frame, only cleared
+	struct GlyphBatch {
+		GLuint atlas = 0;
+		std::vector<Font::GlyphInstance> glyphs;
+	};
+	std::vector<GlyphBatch> glyphBatches;
+	std::vector<Font::GlyphInstance> uploadScratch;
+	std::string fpsText;
 };
 
 /*!***********************************************************************
@@ -181,6 +410,24 @@ public:
 class CollisionSystem {
 public:
 	void update(GameObjectManager& manager, const float& deltaTime);
+
+private:
+	static constexpr float CELL_SIZE = 2.0f;
+	static constexpr int GRID_WIDTH = 20;
+	static constexpr int GRID_HEIGHT = 20;
+
+	//the cells a collider was put in, minX..maxX by minY..maxY
+	struct CellRange {
+		int minX, maxX;
+		int minY, maxY;
+	};
+
+	//all kept from step to step and only emptied, so a step allocates nothing once they have grown
+	std::vector<Layer*> m_layers;
+	std::unordered_map<int, std::vector<GameObject*>> m_collidersByLayer;
+	std::vector<std::vector<Collision::Cell>> m_grid =
+		std::vector<std::vector<Collision::Cell>>(GRID_WIDTH, std::vector<Collision::Cell>(GRID_HEIGHT));
+	std::vector<CellRange> m_cellRanges; //by index into the layer's colliders
 };
 
 // only allow editor in debug mode
@@ -217,6 +464,8 @@ namespace UISystem {
 class LogicSystem {
 public:
 	void update(GameObjectManager& manager, const float& deltaTime);
+private:
+	LogicContainer m_container; // stateless helper, a member so worlds share nothing
 };
 
 class AudioSystem {
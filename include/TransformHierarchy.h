@@ -0,0 +1,100 @@
+/* Start Header ************************************************************************/
+/*!
+\file		TransformHierarchy.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Parent/child links between objects (a weapon or label following the player).
+
+            Transform::x/y/rotation stay the world values, everything that reads them
+            (physics, collision, render, text) keeps working as is. A child additionally
+            keeps its offset from the parent in Transform::local*, and update() brings
+            the two back in sync once per step:
+            - the child's local values were written (markLocalDirty) -> world from local
+            - something moved the child itself (its version moved) -> local from world,
+              so dragging a child in the editor or pushing it around re-attaches it there
+            - only the parent moved -> world from local
+            anything else is skipped, so only the subtrees below a moved object do work.
+
+            The parented objects are kept in one depth first list (parents always before
+            their children), which is what lets a single linear pass resolve every level.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "EntityHandle.h"
+#include "Component.h"
+
+class GameObjectManager;
+
+class TransformHierarchy {
+public:
+    TransformHierarchy() = default;
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    // a null parent detaches. the child stays where it is in the world, only its offset
+    // is worked out again. false if either object is missing a Transform or the parent
+    // sits below the child (that would make a loop)
+    bool setParent(GameObjectManager& manager, EntityHandle child, EntityHandle parent);
+
+    // null handle for objects without a parent
+    EntityHandle getParent(EntityHandle child) const;
+    const std::vector<EntityHandle>& getChildren(EntityHandle parent) const;
+
+    bool hasChildren(EntityHandle parent) const { return !getChildren(parent).empty(); }
+
+    // true if ancestor is object's parent, its parent's parent and so on
+    bool isDescendant(EntityHandle object, EntityHandle ancestor) const;
+
+    // one pass over every parented object, see the top of the file.
+    // systems calling this declare write<Transform>() and write(EngineResource::Hierarchy)
+    void update(GameObjectManager& manager);
+
+    // called by the manager when an object gets deleted, its children become roots
+    // and keep their world position
+    void forget(EntityHandle handle);
+
+    // drops every link (scene switch, the objects are deleted anyway)
+    void clear();
+
+    // child's world values from the parent's world values and the child's offset
+    static void resolveWorld(const Transform& parent, Transform& child);
+
+    // child's offset from where both of them are in the world now
+    static void resolveLocal(const Transform& parent, Transform& child);
+
+private:
+    struct Node {
+        EntityHandle parent;
+        std::vector<EntityHandle> children;
+    };
+
+    struct Link {
+        EntityHandle child;
+        EntityHandle parent;
+    };
+
+    void rebuildOrder();
+
+    // removes child from its parent's list, drops nodes that have nothing left
+    void unlink(EntityHandle child);
+    void eraseIfUnused(EntityHandle handle);
+
+    // only objects that have a parent or children are in here
+    std::unordered_map<EntityHandle, Node, EntityHandleHash> m_nodes;
+
+    // every parented object, depth first. rebuilt lazily after links change
+    std::vector<Link> m_order;
+    bool m_orderDirty = false;
+};
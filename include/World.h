@@ -0,0 +1,112 @@
+/* Start Header ************************************************************************/
+/*!
+\file		World.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 16th, 2026
+\brief      One simulated copy of a level: its objects (and with them the layers, prefab
+            pools and hierarchy), message bus, Lua state and the simulation systems, plus
+            the graphs that run them.
+
+            CoreEngine owns one World for the game and draws it. Headless batch runs
+            (--worlds N) make N of them and step them on separate threads, see
+            CoreEngine::RunHeadless. Nothing a World steps writes to anything outside of
+            it, with two exceptions that are handled by the caller:
+            - the keyboard is one per process, only a World made with ownsInput moves
+              InputHandler's per step key state on. batch worlds only read it
+            - load() goes through the editor selection and the prefab json cache, so
+              worlds are loaded one after another on one thread before any of them steps
+            Shared resources (prefabs, textures, meshes) are only read while stepping.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Systems.h"
+#include "luaSystem.h"
+#include "messageBus.h"
+#include "controllerSystem.h"
+#include "SystemScheduler.h"
+
+class World {
+public:
+    // fixedDt is the step size runSteps uses. ownsInput: see the top of the file
+    explicit World(double fixedDt, bool ownsInput = true);
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    // scene file name in the runtime scene folder or a path. attaches the Lua scripts
+    // too, false if nothing got loaded
+    bool load(const std::string& scene);
+
+    // Lua, the simSteps fixed steps, then the hierarchy once more (see registerSystems).
+    // runs on the calling thread plus whatever workers the JobSystem has
+    void update(float deltaTime, int simSteps);
+
+    // what update runs, for a caller that runs it as part of its own graph instead, in two
+    // parts so systems that only read the last step's results can go in between and run
+    // next to the rest of that step (CoreEngine's TileMap next to Logic):
+    // - registerSimulation: Lua, a sync point, the steps but the last as one barrier, then
+    //   the last step's Interpolation, Physics, Collision and Logic as separate nodes
+    // - registerSimulationEnd: the hierarchy pass
+    // the last step's queued commands are left to the caller's next sync point. call
+    // setFrameSteps before every run of that graph
+    void registerSimulation(SystemScheduler& scheduler);
+    void registerSimulationEnd(SystemScheduler& scheduler);
+    void setFrameSteps(int simSteps) { m_frameSteps = simSteps; }
+
+    GameObjectManager& getManager() { return m_manager; }
+    MessageBus& getMessageBus() { return m_messageBus; }
+    LuaSystem& getLuaSystem() { return m_luaSystem; }
+
+    double getFixedDt() const { return m_fixedDt; }
+    void setFixedDt(double fixedDt) { m_fixedDt = fixedDt; }
+
+    // fixed steps run since the World was made
+    long long getStepCount() const { return m_stepCount; }
+
+    // for the scheduler log
+    const SystemScheduler& getFrameScheduler() const { return m_frameScheduler; }
+    const SystemScheduler& getStepScheduler() const { return m_stepScheduler; }
+
+private:
+    void registerSystems();
+    void runSteps(int simSteps);
+    void finishStep();
+
+    struct StepSystem {
+        std::string name;
+        SystemAccess access;
+        SystemThread thread;
+        SystemScheduler::SystemFn fn;
+        bool inLastStep;   // false: after the last step the frame graph does its job
+    };
+
+    double m_fixedDt;
+    bool m_ownsInput;
+    int m_frameSteps = 0;          // fixed steps due in this update
+    long long m_stepCount = 0;
+
+    // declared first so the objects outlive the Lua state and systems pointing at them
+    GameObjectManager m_manager;
+    MessageBus m_messageBus;
+    LuaSystem m_luaSystem;
+    PlayerControllerSystem m_playerController;
+    PhysicsSystem m_physicsSystem;
+    CollisionSystem m_collisionSystem;
+    LogicSystem m_logicSystem;
+
+    std::vector<StepSystem> m_stepSystems;
+    SystemScheduler m_frameScheduler; // once per update
+    SystemScheduler m_stepScheduler;  // once per fixed step but the last of an update
+};
@@ -77,7 +77,7 @@ namespace Collision {
 
     //Broad phase collision spatial partitioning
     struct Cell {
-        std::vector<GameObject*> objects;
+        std::vector<size_t> objects; // indices into the layer's colliders
         float minX, minY;
         float maxX, maxY;
         Cell() : minX(0), minY(0), maxX(0), maxY(0) {}
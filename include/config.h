@@ -36,6 +36,13 @@ struct AppConfig {
     // debug
     bool        show_input_debug = false;
     bool        show_fps_in_title = true;
+
+    // jobs
+    int         worker_threads = -1; // -1 = one per core minus the main thread, 0 = main thread only
+
+    // simulation
+    int         fixed_hz = 60;        // physics/collision/logic steps per second
+    int         max_steps = 5;        // steps per frame at most, the rest is dropped when a frame runs long
 };
 
 bool LoadConfig(const std::string& path, AppConfig& out, std::string* err = nullptr);
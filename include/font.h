@@ -26,10 +26,18 @@ Technology is prohibited.
 #include "ResourceManager.h"
 
 struct Font {
+    // vbo holds the frame's glyph instances, the vao reads them one per instance
     struct FontMdl {
         GLuint vao, vbo;
     };
 
+    // one glyph quad, the corners come from gl_VertexID in font.vert
+    struct GlyphInstance {
+        glm::vec4 rect;   // x, y of the bottom left corner, width, height, in world units
+        glm::vec4 uv;     // FontCharacter::uvRect
+        GLuint color;     // RGBA8, r in the lowest byte
+    };
+
     //struct Character {
     //    GLuint TextureID;  // ID handle of the glyph texture
     //    glm::ivec2   Size;       // Size of glyph
@@ -19,7 +19,7 @@ Technology is prohibited.
 
 //storing of each character for the chosen font
 struct FontCharacter {
-    GLuint TextureID;
+    glm::vec4 uvRect;   // u0, v0, u1, v1 in the font's atlas, v0 is the glyph's top row
     glm::ivec2 Size;
     glm::ivec2 Bearing;
     GLuint Advance;
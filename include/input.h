@@ -42,6 +42,7 @@ GLFW_KEY_SPACE
 class InputHandler {
 public:
 	// initialize input handler with window and set up callbacks
+	// window can be nullptr (headless), the key states then only change through code
 	static void init(GLFWwindow* window, const AppConfig& cfg);
 	// update input states (call once per frame)  (DO NOT call glfwPollEvents again in game loop)
 	static void update();
@@ -58,6 +59,26 @@ public:
 	// check if both keys are being held down (default is left shift)
 	static bool isComboKeyHeld(int key1, int key2 = GLFW_KEY_LEFT_CONTROL);
 
+	/* fixed step simulation input */
+	// check if key was pressed since the previous simulation step. a frame can run
+	// 0, 1 or several steps, this makes every press land in exactly one of them
+	static bool isKeyTriggeredThisStep(int key);
+	// remember the key states at the end of a simulation step (call after every step)
+	static void endSimulationStep();
+
+	/* recording and replay (see InputRecorder) */
+	// everything the game reads from the keyboard and mouse in one frame
+	struct FrameInput {
+		bool keys[1024];
+		bool mouseButtons[8];
+		Vector2D mousePosition;
+		float scroll;
+	};
+	// the state update() left behind this frame
+	static void captureFrame(FrameInput& out);
+	// replaces this frame's state (call right after update(), overrides what GLFW reported)
+	static void applyFrame(const FrameInput& in);
+
 	/* check for mouse button */
 	// check if left mouse button was clicked
 	static bool isMouseLeftClicked();
@@ -135,6 +156,7 @@ private:
 
 	static bool m_keys[1024];
 	static bool m_keysPrevious[1024];
+	static bool m_keysPreviousStep[1024]; // as of the last simulation step
 
 	static bool m_mouseButtons[8];
 	static bool m_mouseButtonsPrevious[8];
@@ -0,0 +1,35 @@
+/* Start Header ************************************************************************/
+/*!
+\file		jobBenchmark.h
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Micro benchmark for the job system, times the parallel render batching pass
+            over a large scene at every worker count. Run with --bench-jobs.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#pragma once
+
+/*!***********************************************************************
+\brief
+	builds spriteCount Transform + Render objects and times
+	RenderSystem::batchingSetUp with 1 up to hardware_concurrency threads,
+	printing the average time per frame and the speedup over 1 thread.
+	needs no window or GL context
+
+\param[in] spriteCount
+	number of sprites in the scene
+
+\param[in] frames
+	number of timed batching passes per thread count
+
+\return
+	0 on success
+*************************************************************************/
+int RunJobBenchmark(int spriteCount = 50000, int frames = 100);
@@ -50,6 +50,9 @@ public:
 	//get all layers
 	std::vector<Layer*> getAllLayers() const;
 
+	//get all layers into layers, cleared first. for callers that keep the vector every frame
+	void getAllLayers(std::vector<Layer*>& layers) const;
+
 	//clear all objects from all layers
 	void clearAllLayers();
 
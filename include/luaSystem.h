@@ -17,6 +17,8 @@ Technology is prohibited.
 #pragma once
 #include <string>
 #include <iostream>
+#include <filesystem>
+#include <unordered_map>
 #include "GameObject.h"
 #include "input.h"
 #include "Component.h"
@@ -42,16 +44,23 @@ public:
 	float getGlobalNumber(const std::string& name); //to get the global number variable from Lua
     bool updateObjectScript(const std::string& tableName, GameObject* obj, float deltaTime); //update the script 
     bool loadScriptForObject(const std::string& filename, const std::string& tableName); //load script
+    void attachScripts(GameObjectManager& manager, const std::string& folder = "./assets/scripting"); //give every object named like a script in folder its LuaScript
 	static int Lua_getPosition(lua_State* L); //get position of object
 	static int Lua_setPosition(lua_State* L); //set position of object
 	static int Lua_IsKeyHeld(lua_State* L); //check if key is held
 	static int Lua_SendInputEvent(lua_State* L); //send input event
+	static int Lua_PoolAcquire(lua_State* L); //take a free object from a prefab pool
+	static int Lua_PoolRelease(lua_State* L); //give a pooled object back
+	static int Lua_setParent(lua_State* L); //attach an object to another one
+	static GameObject* getObjectArg(lua_State* L, int index); //resolve the object handle passed from Lua
 	void setMessageBus(MessageBus* bus) { messageBus = bus; } //set message bus
 	void update(GameObjectManager& manager, float deltaTime); //update all Lua scripts
 
 private:
 	lua_State* L = nullptr; //pointer to Lua state
 	MessageBus* messageBus = nullptr; //pointer to message bus
+	GameObjectManager* gameObjectManager = nullptr; //manager of the objects being scripted, set every update
 	//std::unique_ptr<GameObjectManager> manager; //pointer to game object manager
 	GUISystem* guiSystem = nullptr; //pointer to GUI system
+	std::unordered_map<std::string, std::filesystem::file_time_type> fileTimes; //when each script was last loaded into this state
 };
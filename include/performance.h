@@ -27,4 +27,16 @@ struct SystemTimer {
 };
 
 extern std::vector<SystemTimer> g_SystemTimers;
+void PushSystemTimer(const std::string& name, double ms); //thread safe, systems can run on worker threads
 void LogSystemTimersEveryInterval(float deltaTime, double intervalSeconds = 15.0); //for console
+
+//heap allocation counters, counted in every build (global new/delete are replaced in performance.cpp)
+struct AllocationStats {
+	size_t allocations = 0;
+	size_t frees = 0;
+	size_t bytes = 0; //bytes requested, frees do not know their size
+};
+
+extern AllocationStats g_FrameAllocations; //allocations made during the last full frame
+AllocationStats GetAllocationTotals(); //since program start
+void MarkAllocationFrame(); //call once at the start of every frame to update g_FrameAllocations
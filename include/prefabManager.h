@@ -61,6 +61,8 @@ public:
 
 	// find prefabid by filename, this will auto remove the parent folder
 	std::string findPrefabIDByFilename(const std::filesystem::path& filename);
+	// whether the id is in the registry
+	bool hasPrefab(const std::string& prefabID) const { return m_prefabRegistry.count(prefabID) != 0; }
 	/* -------- END -------- */
 
 
@@ -19,9 +19,13 @@ Technology is prohibited.
 #include <glm/glm.hpp>
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <array>
+#include <cmath>
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include <input.h>
 
 #include "ResourceManager.h"
@@ -50,7 +54,7 @@ enum class cameraMode {
 
 struct BatchKey {
 	shape meshType;
-	GLuint texID;
+	GLuint texID; // GL_TEXTURE_2D_ARRAY, the layer goes in InstanceData
 
 	bool operator==(const BatchKey& other) const noexcept {
 		return meshType == other.meshType && texID == other.texID;
@@ -81,14 +85,55 @@ struct renderer
 {
 	/*!***********************************************************************
 	\brief
-		Data layout for one instance (transform, color, texture offset/scale)
+		Data layout for one instance (transform, color, texture offset/scale),
+		packed to 36 bytes. the vertex shaders build the model matrix from
+		position/rotation/scale (translate * rotate * scale, as the CPU did),
+		so fill it through the setters rather than by hand
 	*************************************************************************/
 	struct InstanceData
 	{
-		glm::mat4 model;      
-		glm::vec4 color;      
-		glm::vec4 texParams;  
+		glm::vec2 position{ 0.f, 0.f };
+		glm::vec2 scale{ 1.f, 1.f };  // x is negative when flipped
+		GLshort rotation = 0;         // snorm16, radians / pi
+		GLshort depth = 0;            // snorm16, z (the cameras clip at -1..1)
+		GLuint color = 0xFFFFFFFFu;   // RGBA8, r in the lowest byte
+		GLushort texParams[4] = { 0, 0, 0xFFFF, 0xFFFF }; // unorm16 uv offset xy, uv scale zw
+		GLushort texLayer = 0;        // layer of the array texture bound for the draw
+		GLubyte texSlot = 0;          // texture unit that array is on, set by queueInstances
+		GLubyte padding = 0;
+
+		void setTransform(float x, float y, float z, float rotationDegrees, float scaleX, float scaleY)
+		{
+			// wrapped to -pi..pi so any angle fits the snorm
+			float angle = std::remainder(glm::radians(rotationDegrees), glm::two_pi<float>());
+			position = glm::vec2(x, y);
+			scale = glm::vec2(scaleX, scaleY);
+			rotation = packSnorm16(angle / glm::pi<float>());
+			depth = packSnorm16(z);
+		}
+
+		void setColor(const glm::vec4& rgba)
+		{
+			color = 0;
+			for (int i = 0; i < 4; ++i) {
+				color |= static_cast<GLuint>(std::lround(glm::clamp(rgba[i], 0.f, 1.f) * 255.f)) << (i * 8);
+			}
+		}
+
+		// uv = aTexCoord * zw + xy, everything in 0..1
+		void setTexParams(const glm::vec4& params)
+		{
+			for (int i = 0; i < 4; ++i) {
+				texParams[i] = static_cast<GLushort>(std::lround(glm::clamp(params[i], 0.f, 1.f) * 65535.f));
+			}
+		}
+
+		static GLshort packSnorm16(float value)
+		{
+			return static_cast<GLshort>(std::lround(glm::clamp(value, -1.f, 1.f) * 32767.f));
+		}
 	};
+	static_assert(sizeof(InstanceData) == 36, "the instance attributes expect a 36 byte stride");
 	/*!***********************************************************************
 	\brief
 		initializes the setups for the meshes and shader programs
@@ -102,6 +147,21 @@ struct renderer
 	*************************************************************************/
 	static void init(int w, int h);
 
+	/*!***********************************************************************
+	\brief
+		headless version of init, no GL context. sets up the cameras and one
+		placeholder model per shape (no GL objects) so scenes can still
+		reference renderer::models
+
+	\param[in] w
+		width the cameras assume
+
+	\param[in] h
+		height the cameras assume
+
+	*************************************************************************/
+	static void initHeadless(int w, int h);
+
 	// Update camera aspect when window size changes
 	static void onResize(int w, int h);
 
@@ -120,37 +180,326 @@ struct renderer
 		GLuint elem_cnt;
 		GLuint draw_cnt;
 		GLuint primitive_cnt;
+		GLuint first_index;  // where the model's indices start in meshBuffer
+		GLint base_vertex;   // where its vertices start
 
-		GLuint instanceVBO = 0;
-		GLsizei maxInstances = 5000; 
+		model() : shape(shape::square), primitive_type(GL_TRIANGLES), vaoid(0), vbo(0), ebo(0), elem_cnt(0), draw_cnt(0), primitive_cnt(0), first_index(0), base_vertex(0) {}
+	};
+
+	/*!***********************************************************************
+	\brief
+		every model's vertices and indices live in one buffer pair behind one
+		VAO, so batches of different shapes can go out in the same multi draw.
+		setup_square/setup_circle add to the vectors, setup_mesh_buffer
+		uploads them once all the models are made
+	*************************************************************************/
+	struct MeshVertex
+	{
+		glm::vec2 pos;
+		glm::vec3 clr;
+		glm::vec2 tex;
+	};
 
-		model() : shape(shape::square), primitive_type(GL_TRIANGLES), vaoid(0), vbo(0), ebo(0), elem_cnt(0), draw_cnt(0), primitive_cnt(0) {}
+	struct MeshBuffer
+	{
+		GLuint vao = 0;
+		GLuint vbo = 0;
+		GLuint ebo = 0;
+		std::vector<MeshVertex> vertices;
+		std::vector<GLushort> indices;
 	};
+	static MeshBuffer meshBuffer;
+
 	/*!***********************************************************************
 	\brief
-		Sets up instancing attributes for a given model
+		uploads meshBuffer and points every model at its VAO
+	*************************************************************************/
+	static void setup_mesh_buffer();
 
-	\param[in] mdl
-		the mesh/model that is being drawn
+	/*!***********************************************************************
+	\brief
+		Sets up instancing attributes on a VAO
+
+	\param[in] vao
+		the VAO the instances are drawn with
+
+	\param[in] buffer
+		where the instances are read from, the instance ring or a static
+		batch's buffer
 	*************************************************************************/
-	static void setup_instance_attributes(model& mdl);
+	static void setup_instance_attributes(GLuint vao, GLuint buffer);
 
 	/*!***********************************************************************
 	\brief
-		Draws multiple instances of a model in one call
+		Queues one batch for the next submitDrawList. the instances are copied
+		straight into the current frame's part of the instance ring and the
+		draw command into the draw list, nothing is drawn yet
 
-	\param[in]
+	\param[in] mdl
 		the mesh/model that is being drawn
 
 	\param[in] instances
-		relevent data to show how i should draw my mesh
+		relevent data to show how i should draw my mesh. any count, the ring
+		grows when a frame needs more than it holds
+
+	\param[in] texture
+		array texture the batch samples, 0 for none. it gets one of the
+		TEXTURE_SLOTS units for the multi draw, the list submits by itself
+		when they run out
+	*************************************************************************/
+	static void queueInstances(const model& mdl, const std::vector<InstanceData>& instances, GLuint texture = 0);
+
+	/*!***********************************************************************
+	\brief
+		draws everything queued since the last submit with one
+		glMultiDrawElementsIndirect, using whatever program is bound. call
+		once per shader after its batches are queued
+	*************************************************************************/
+	static void submitDrawList();
+
+	/*!***********************************************************************
+	\brief
+		One persistently mapped buffer that every model's instance attributes
+		read from, split into FRAME_REGIONS parts. a frame writes only into its
+		own part, and the fence set at the end of the frame tells when the GPU
+		is done with it, so the CPU never writes into data still being drawn
+		and the driver never has to sync on a buffer update.
+	*************************************************************************/
+	static constexpr int FRAME_REGIONS = 3;
+
+	struct InstanceRing
+	{
+		GLuint buffer = 0;
+		InstanceData* mapped = nullptr;           // whole buffer, stays mapped
+		GLsizei regionInstances = 0;              // instances one frame can draw
+		int region = 0;                           // part the current frame writes to
+		GLsizei head = 0;                         // instances written this frame
+		std::array<GLsync, FRAME_REGIONS> fences{};
+	};
+	static InstanceRing instanceRing;
+
+	/*!***********************************************************************
+	\brief
+		the frame's draw commands, in a persistently mapped
+		GL_DRAW_INDIRECT_BUFFER split into FRAME_REGIONS parts the same way
+		as the instance ring and guarded by the same fences. textures holds
+		the arrays the pending commands sample, bound to units 0.. on submit
+	*************************************************************************/
+	static constexpr int TEXTURE_SLOTS = 16;
+
+	struct DrawElementsIndirectCommand
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	struct DrawList
+	{
+		GLuint buffer = 0;
+		DrawElementsIndirectCommand* mapped = nullptr;
+		GLsizei regionCommands = 0;               // commands one frame can queue
+		GLsizei head = 0;                         // commands queued this frame
+		GLsizei submitted = 0;                    // commands already drawn this frame
+		std::array<GLuint, TEXTURE_SLOTS> textures{};
+		int textureCount = 0;
+	};
+	static DrawList drawList;
+
+	/*!***********************************************************************
+	\brief
+		instance counts for the performance window. the frame values are reset
+		by beginInstanceFrame, the peaks are kept for the whole run
+	*************************************************************************/
+	struct InstanceStats
+	{
+		GLsizei frameInstances = 0;
+		GLsizei frameBatches = 0;  // what used to be one draw call each
+		GLsizei frameDrawCalls = 0; // multi draws actually issued
+		GLsizei frameStaticBatches = 0;   // drawn this frame, see StaticBatch
+		GLsizei frameStaticInstances = 0; // in those, none of them copied
+		GLsizei largestBatch = 0;  // this frame
+		GLsizei peakBatch = 0;
+		GLsizei peakFrame = 0;
+		int grows = 0;             // times the ring had to grow
+		int staticBuilds = 0;      // build_static_batch calls, should only move on edits
+	};
+	static InstanceStats instanceStats;
+
+	/*!***********************************************************************
+	\brief
+		creates and maps the instance ring, before any model is set up
+
+	\param[in] regionInstances
+		instances one frame can draw
+	*************************************************************************/
+	static void setup_instance_ring(GLsizei regionInstances);
+
+	/*!***********************************************************************
+	\brief
+		replaces the ring with one whose regions hold at least regionInstances
+		and points the mesh VAO at it. the draws already submitted this frame
+		keep the old buffer alive until the GPU is done with them
+
+	\param[in] regionInstances
+		instances the current frame needs room for
+	*************************************************************************/
+	static void grow_instance_ring(GLsizei regionInstances);
+
+	/*!***********************************************************************
+	\brief
+		creates and maps the draw list's indirect buffer
+
+	\param[in] regionCommands
+		commands one frame can queue
+	*************************************************************************/
+	static void setup_draw_list(GLsizei regionCommands);
+
+	/*!***********************************************************************
+	\brief
+		replaces the indirect buffer with a bigger one. only called right
+		after a submit, so nothing queued is lost
+
+	\param[in] regionCommands
+		commands the current frame needs room for
+	*************************************************************************/
+	static void grow_draw_list(GLsizei regionCommands);
+
+	/*!***********************************************************************
+	\brief
+		moves on to the next part of the instance ring and draw list, waiting
+		for the GPU if it is still drawing the frame that used it last. call
+		before the first queueInstances of a frame
+	*************************************************************************/
+	static void beginInstanceFrame();
+
+	/*!***********************************************************************
+	\brief
+		fences the current part of the instance ring and draw list, call
+		after the last submitDrawList of a frame
 	*************************************************************************/
-	static void drawInstances(model& mdl, const std::vector<InstanceData>& instances);
+	static void endInstanceFrame();
+
+	/*!***********************************************************************
+	\brief
+		instances that stay on the GPU from frame to frame, for content that
+		does not move (tile maps, backgrounds). build_static_batch puts them
+		in a buffer of their own with their draw commands, and every frame
+		after that drawing them is one multi draw with nothing copied. the
+		owner rebuilds it when the content changes and destroys it when done.
+
+		the instances go in by array texture like the dynamic batches, each
+		array gets a unit for the draw. a batch with more than TEXTURE_SLOTS
+		arrays is drawn in several passes
+	*************************************************************************/
+	struct StaticPass
+	{
+		GLsizei firstCommand = 0;
+		GLsizei commandCount = 0;
+		std::array<GLuint, TEXTURE_SLOTS> textures{};
+		int textureCount = 0;
+	};
+
+	struct StaticBatch
+	{
+		GLuint vao = 0;        // meshBuffer's vertices, instances from buffer
+		GLuint buffer = 0;     // the instances, immutable
+		GLuint commands = 0;   // GL_DRAW_INDIRECT_BUFFER, one command per BatchKey
+		GLsizei instanceCount = 0;
+		std::vector<StaticPass> passes; // one multi draw each, normally just one
+	};
+
+	/*!***********************************************************************
+	\brief
+		(re)builds batch from the given instances, grouped like the dynamic
+		batches. whatever batch held before is destroyed first. empty batches
+		make no GL objects and draw nothing
+
+	\param[in] batch
+		the batch to fill
+
+	\param[in] batches
+		instances by mesh and array texture, every key needs a texture
+	*************************************************************************/
+	static void build_static_batch(StaticBatch& batch, const std::unordered_map<BatchKey, std::vector<InstanceData>, BatchKeyHash>& batches);
+
+	/*!***********************************************************************
+	\brief
+		draws a static batch with whatever program is bound, hasTex. call
+		between beginInstanceFrame and endInstanceFrame like the queues, it
+		binds its own textures so it can go before or after any submit
+	*************************************************************************/
+	static void draw_static_batch(const StaticBatch& batch);
+
+	/*!***********************************************************************
+	\brief
+		deletes the batch's GL objects and empties it
+	*************************************************************************/
+	static void destroy_static_batch(StaticBatch& batch);
 	/*!***********************************************************************
 	\brief
 		storing of shader program
 	*************************************************************************/
 	static std::vector<GLuint> shdr_pgm;
+
+	/*!***********************************************************************
+	\brief
+		constants every program reads the same for a whole frame, in one
+		uniform buffer bound to FRAME_DATA_BINDING for good. the shaders
+		declare it as
+
+			layout(std140, binding = 0) uniform FrameData {
+				mat4 view; mat4 proj; float time; float deltaTime; vec2 resolution;
+			};
+
+		and this struct has to keep the same std140 layout
+	*************************************************************************/
+	struct FrameData
+	{
+		glm::mat4 view{ 1.f };
+		glm::mat4 proj{ 1.f };
+		float time = 0.f;             // seconds drawn so far
+		float deltaTime = 0.f;
+		glm::vec2 resolution{ 0.f };  // of the target being drawn to, in pixels
+	};
+	static_assert(sizeof(FrameData) == 144, "FrameData has to match the std140 block in the shaders");
+
+	static constexpr GLuint FRAME_DATA_BINDING = 0;
+	static GLuint frameDataBuffer;
+	static FrameData frameData;
+
+	/*!***********************************************************************
+	\brief
+		makes the frame data buffer and binds it, once at init
+	*************************************************************************/
+	static void setup_frame_data();
+
+	/*!***********************************************************************
+	\brief
+		uploads this frame's constants, once before anything is drawn
+
+	\param[in] view
+		camera view matrix
+
+	\param[in] proj
+		camera projection matrix
+
+	\param[in] deltaTime
+		frame time, added on to time
+
+	\param[in] resolution
+		size of the target in pixels
+	*************************************************************************/
+	static void updateFrameData(const glm::mat4& view, const glm::mat4& proj, float deltaTime, const glm::vec2& resolution);
+
+	/*!***********************************************************************
+	\brief
+		swaps just the camera, for a pass later in the frame that draws with
+		another one (text). uploads nothing if it is the same camera
+	*************************************************************************/
+	static void updateFrameCamera(const glm::mat4& view, const glm::mat4& proj);
 	/*!***********************************************************************
 	\brief
 		setting up square mesh
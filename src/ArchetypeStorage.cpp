@@ -0,0 +1,298 @@
+/* Start Header ************************************************************************/
+/*!
+\file		ArchetypeStorage.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Archetype based component storage. Handles chunk layout, moving objects
+            between archetypes when components are added/removed and keeping rows
+            tightly packed when objects are destroyed.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "ArchetypeStorage.h"
+#include "GameObject.h"
+
+#include <algorithm>
+
+namespace {
+	size_t alignUp(size_t value, size_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	bool typeLess(const ComponentTypeInfo* a, const ComponentTypeInfo* b) {
+		return a->id < b->id;
+	}
+}
+
+/* ------------------------------ ChunkPool ------------------------------ */
+
+ChunkPool::~ChunkPool() {
+	for (std::byte* chunk : m_free) {
+		::operator delete(chunk, std::align_val_t{ Archetype::CHUNK_ALIGN });
+	}
+}
+
+std::byte* ChunkPool::acquire() {
+	if (!m_free.empty()) {
+		std::byte* chunk = m_free.back();
+		m_free.pop_back();
+		return chunk;
+	}
+
+	++m_allocated;
+	return static_cast<std::byte*>(::operator new(Archetype::CHUNK_BYTES, std::align_val_t{ Archetype::CHUNK_ALIGN }));
+}
+
+void ChunkPool::release(std::byte* chunk) {
+	m_free.push_back(chunk);
+}
+
+/* ------------------------------ Archetype ------------------------------ */
+
+Archetype::Archetype(std::vector<const ComponentTypeInfo*> types, ChunkPool* pool) : m_types(std::move(types)) {
+	m_columnOf.fill(-1);
+	for (size_t column = 0; column < m_types.size(); ++column) {
+		m_signature.set(m_types[column]->id);
+		m_columnOf[m_types[column]->id] = static_cast<int>(column);
+	}
+
+	// work out how many rows fit in one chunk:
+	// [owners][column 0][column 1]...  every column aligned for its own type
+	size_t rowBytes = sizeof(GameObject*);
+	for (const ComponentTypeInfo* info : m_types) rowBytes += info->size;
+
+	auto layoutBytes = [this](size_t capacity) {
+		size_t offset = sizeof(GameObject*) * capacity;
+		m_columnOffsets.clear();
+		for (const ComponentTypeInfo* info : m_types) {
+			offset = alignUp(offset, info->align);
+			m_columnOffsets.push_back(offset);
+			offset += info->size * capacity;
+		}
+		return offset;
+	};
+
+	m_chunkCapacity = std::max<size_t>(1, CHUNK_BYTES / rowBytes);
+	while (m_chunkCapacity > 1 && layoutBytes(m_chunkCapacity) > CHUNK_BYTES) {
+		--m_chunkCapacity;
+	}
+
+	// a single huge row may not fit in the default chunk size, grow the chunk instead
+	m_chunkBytes = std::max(CHUNK_BYTES, alignUp(layoutBytes(m_chunkCapacity), CHUNK_ALIGN));
+
+	// oversized chunks are rare, they just go straight to the heap
+	if (m_chunkBytes == CHUNK_BYTES) m_pool = pool;
+}
+
+Archetype::~Archetype() {
+	while (m_size > 0) {
+		removeRow(m_size - 1);
+	}
+	for (std::byte* chunk : m_chunks) {
+		freeChunk(chunk);
+	}
+}
+
+std::byte* Archetype::allocateChunk() {
+	if (m_pool) return m_pool->acquire();
+	return static_cast<std::byte*>(::operator new(m_chunkBytes, std::align_val_t{ CHUNK_ALIGN }));
+}
+
+void Archetype::freeChunk(std::byte* chunk) {
+	if (m_pool) m_pool->release(chunk);
+	else ::operator delete(chunk, std::align_val_t{ CHUNK_ALIGN });
+}
+
+size_t Archetype::pushRow(GameObject* owner) {
+	if (m_size == m_chunks.size() * m_chunkCapacity) {
+		m_chunks.push_back(allocateChunk());
+	}
+
+	size_t row = m_size++;
+	getOwner(row) = owner;
+	return row;
+}
+
+GameObject* Archetype::removeRow(size_t row) {
+	for (size_t column = 0; column < m_types.size(); ++column) {
+		m_types[column]->destroy(getComponent(row, static_cast<int>(column)));
+	}
+
+	size_t last = m_size - 1;
+	GameObject* moved = nullptr;
+
+	// keep the rows packed by moving the last one into the hole
+	if (row != last) {
+		for (size_t column = 0; column < m_types.size(); ++column) {
+			void* src = getComponent(last, static_cast<int>(column));
+			m_types[column]->moveConstruct(getComponent(row, static_cast<int>(column)), src);
+			m_types[column]->destroy(src);
+		}
+		moved = getOwner(last);
+		getOwner(row) = moved;
+	}
+
+	--m_size;
+
+	// release the last chunk once it is empty
+	if (m_size == (m_chunks.size() - 1) * m_chunkCapacity) {
+		freeChunk(m_chunks.back());
+		m_chunks.pop_back();
+	}
+
+	return moved;
+}
+
+/* --------------------------- ArchetypeStorage --------------------------- */
+
+ArchetypeStorage::ArchetypeStorage() {
+	m_root = findOrCreate({});
+}
+
+ArchetypeStorage::~ArchetypeStorage() {
+	// objects should be gone by now, anything left just has its components destroyed
+	m_archetypes.clear();
+}
+
+ArchetypeStorage& ArchetypeStorage::detached() {
+	// intentionally never freed, temp objects owned by other singletons can outlive any static
+	static ArchetypeStorage* storage = new ArchetypeStorage();
+	return *storage;
+}
+
+void ArchetypeStorage::attach(GameObject& obj) {
+	obj.m_archetype = m_root;
+	obj.m_row = m_root->pushRow(&obj);
+}
+
+void ArchetypeStorage::detach(GameObject& obj) {
+	if (!obj.m_archetype) return;
+
+	relocate(obj.m_archetype->removeRow(obj.m_row), obj.m_row);
+	obj.m_archetype = nullptr;
+	obj.m_row = 0;
+}
+
+void* ArchetypeStorage::addComponent(GameObject& obj, const ComponentTypeInfo& info) {
+	Archetype* src = obj.m_archetype;
+
+	// already has one, replace it in place
+	int column = src->getColumn(info.id);
+	if (column >= 0) {
+		void* slot = src->getComponent(obj.m_row, column);
+		info.destroy(slot);
+		return slot;
+	}
+
+	Archetype* dst = src->addEdges[info.id];
+	if (!dst) {
+		std::vector<const ComponentTypeInfo*> types = src->getTypes();
+		types.insert(std::upper_bound(types.begin(), types.end(), &info, typeLess), &info);
+		dst = findOrCreate(std::move(types));
+		src->addEdges[info.id] = dst;
+		dst->removeEdges[info.id] = src;
+	}
+
+	migrate(obj, *dst);
+	return dst->getComponent(obj.m_row, dst->getColumn(info.id));
+}
+
+bool ArchetypeStorage::removeComponent(GameObject& obj, ComponentID id) {
+	Archetype* src = obj.m_archetype;
+	if (src->getColumn(id) < 0) return false;
+
+	Archetype* dst = src->removeEdges[id];
+	if (!dst) {
+		std::vector<const ComponentTypeInfo*> types = src->getTypes();
+		types.erase(std::remove_if(types.begin(), types.end(),
+			[id](const ComponentTypeInfo* info) { return info->id == id; }), types.end());
+		dst = findOrCreate(std::move(types));
+		src->removeEdges[id] = dst;
+		dst->addEdges[id] = src;
+	}
+
+	// the removed component is not moved across, removeRow destroys it
+	migrate(obj, *dst);
+	return true;
+}
+
+void ArchetypeStorage::cloneComponents(const GameObject& src, GameObject& dst) {
+	Archetype* archetype = src.m_archetype;
+	if (!archetype || archetype == dst.m_archetype) return;
+
+	// leave the empty archetype and take a row next to the source object
+	relocate(dst.m_archetype->removeRow(dst.m_row), dst.m_row);
+
+	size_t row = archetype->pushRow(&dst);
+	const std::vector<const ComponentTypeInfo*>& types = archetype->getTypes();
+	for (size_t column = 0; column < types.size(); ++column) {
+		types[column]->cloneConstruct(archetype->getComponent(row, static_cast<int>(column)),
+			archetype->getComponent(src.m_row, static_cast<int>(column)));
+	}
+
+	dst.m_archetype = archetype;
+	dst.m_row = row;
+}
+
+Archetype* ArchetypeStorage::findOrCreate(std::vector<const ComponentTypeInfo*> types) {
+	ComponentSignature signature;
+	for (const ComponentTypeInfo* info : types) signature.set(info->id);
+
+	auto iterator = m_lookup.find(signature);
+	if (iterator != m_lookup.end()) return iterator->second;
+
+	m_archetypes.push_back(std::make_unique<Archetype>(std::move(types), &m_chunkPool));
+	Archetype* archetype = m_archetypes.back().get();
+	m_lookup.emplace(signature, archetype);
+
+	// keep the cached views current
+	std::lock_guard<std::mutex> lock(m_queryMutex);
+	for (auto& [mask, query] : m_queries) {
+		if ((signature & mask) == mask) query->archetypes.push_back(archetype);
+	}
+	return archetype;
+}
+
+ArchetypeQuery& ArchetypeStorage::getQuery(const ComponentSignature& mask) {
+	std::lock_guard<std::mutex> lock(m_queryMutex);
+	std::unique_ptr<ArchetypeQuery>& query = m_queries[mask];
+	if (!query) {
+		query = std::make_unique<ArchetypeQuery>();
+		query->mask = mask;
+		for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+			if ((archetype->getSignature() & mask) == mask) query->archetypes.push_back(archetype.get());
+		}
+	}
+	return *query;
+}
+
+void ArchetypeStorage::migrate(GameObject& obj, Archetype& dst) {
+	Archetype& src = *obj.m_archetype;
+	size_t srcRow = obj.m_row;
+	size_t dstRow = dst.pushRow(&obj);
+
+	const std::vector<const ComponentTypeInfo*>& types = src.getTypes();
+	for (size_t column = 0; column < types.size(); ++column) {
+		int dstColumn = dst.getColumn(types[column]->id);
+		if (dstColumn < 0) continue;
+
+		types[column]->moveConstruct(dst.getComponent(dstRow, dstColumn),
+			src.getComponent(srcRow, static_cast<int>(column)));
+	}
+
+	// destroys whatever is left in the old row (moved-from or removed components)
+	relocate(src.removeRow(srcRow), srcRow);
+
+	obj.m_archetype = &dst;
+	obj.m_row = dstRow;
+}
+
+void ArchetypeStorage::relocate(GameObject* moved, size_t row) {
+	if (moved) moved->m_row = row;
+}
@@ -26,6 +26,26 @@ Technology is prohibited.
 #include "CoreEngine.h"
 #include "GUISystem.h"  // Add this include
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace {
+    //adds this frame's g_SystemTimers to the per system totals and clears them
+    void collectSystemTimers(std::vector<SystemTimer>& totals) {
+        for (const SystemTimer& timer : g_SystemTimers) {
+            auto total = std::find_if(totals.begin(), totals.end(),
+                [&timer](const SystemTimer& entry) { return entry.name == timer.name; });
+            if (total == totals.end()) totals.push_back(timer);
+            else total->ms += timer.ms;
+        }
+        g_SystemTimers.clear();
+    }
+}
+
 CoreEngine::CoreEngine()
     : m_window(nullptr), 
     m_fps(0.0), 
@@ -120,40 +140,44 @@ void CoreEngine::Init(bool forceWindowed) {
     // --- System Initialization ---
     AudioHandler::getInstance().init();
 
+    //worker threads for the system scheduler and parallel loops
+    JobSystem::getInstance().init(cfg.worker_threads);
+
+    //fixed step simulation rate, a replay keeps the one it was recorded with
+    if (!m_recorder.isActive()) m_fixedDt = 1.0 / std::max(cfg.fixed_hz, 1);
+    m_maxSteps = std::max(cfg.max_steps, 1);
+
     InputHandler::init(m_window, cfg);
     renderer::init(winWidth, winHeight);
 
-    m_manager = std::make_unique<GameObjectManager>();
-	m_logicSystem = std::make_unique<LogicSystem>();
+    m_world = std::make_unique<World>(m_fixedDt);
+    m_manager = &m_world->getManager();
     m_inputSystem = std::make_unique<InputSystem>();
-    m_collisionSystem = std::make_unique<CollisionSystem>();
-    m_physicsSystem = std::make_unique<PhysicsSystem>();
     m_renderSystem = std::make_unique<RenderSystem>();
     #ifdef _DEBUG
     m_uiSystem = std::make_unique<UISystem>();
     #endif
-    m_luaSystem = std::make_unique<LuaSystem>();
     m_fontSystem = std::make_unique<FontSystem>();
     m_guiSystem = std::make_unique<GUISystem>();
-    m_messageBus = std::make_unique<MessageBus>();
-    m_playerController = std::make_unique<PlayerControllerSystem>();
     m_audioSystem = std::make_unique<AudioSystem>();
     m_tileMapSystem = std::make_unique<TileMapSystem>();
 
 
     PrefabManager::Instance().loadPrefabRegistry();
-    m_guiSystem->init(*m_manager, *m_luaSystem);
-    m_luaSystem->init();
+    m_guiSystem->init(*m_manager, m_world->getLuaSystem());
     m_renderSystem->init(*m_manager, winWidth, winHeight);
     #ifdef _DEBUG
 	    m_uiSystem->init(m_window, m_renderSystem.get());
     #endif
-    m_fontSystem->init(*m_manager);
+    m_fontSystem->init();
     m_audioSystem->init(*m_manager);
 
-    //advance messaging 
-    m_messageBus->subscribe("KeyPressed", m_playerController.get());
-    m_messageBus->subscribe("KeyReleased", m_playerController.get());
+    registerSystems();
+
+    //a replay skips the menu and starts in the recorded scene
+    if (m_recorder.getMode() == InputRecorder::Mode::Replaying) {
+        m_guiSystem->startGame(*m_manager, m_recorder.getScene());
+    }
 
     glfwPollEvents();
     m_isRunning = true;
@@ -163,6 +187,192 @@ void CoreEngine::Init(bool forceWindowed) {
     //AudioHandler::getInstance().playSound(soundID::bg, 0.2f);
 }
 
+void CoreEngine::InitHeadless(const std::string& scene, int worlds) {
+    AppConfig cfg;
+    std::string err;
+    if (!LoadConfig(std::string(RUNTIME_RES_DIR_R) + "/config.json", cfg, &err)) {
+        std::cout << err << "\n";
+    }
+
+    m_title = cfg.title;
+    m_headless = true;
+
+    //the worlds are what runs in parallel in a batch, their systems stay on their own thread
+    //instead of all of them queueing up on one set of workers
+    const bool batch = worlds > 1;
+    JobSystem::getInstance().init(batch ? 0 : cfg.worker_threads);
+
+    //fixed step simulation rate, a replay keeps the one it was recorded with
+    if (!m_recorder.isActive()) m_fixedDt = 1.0 / std::max(cfg.fixed_hz, 1);
+    m_maxSteps = std::max(cfg.max_steps, 1);
+
+    //no window: keys stay up unless something sets them, cameras and meshes are placeholders
+    InputHandler::init(nullptr, cfg);
+    renderer::initHeadless(cfg.width, cfg.height);
+
+    PrefabManager::Instance().loadPrefabRegistry();
+
+#ifdef _DEBUG
+    //the editor starts in editing mode, which freezes everything that moves
+    EditorManager::toggleEditing(false);
+#endif
+
+    if (batch) {
+        //loaded one after another here, only the stepping is threaded (see World.h)
+        for (int index = 0; index < worlds; ++index) {
+            auto world = std::make_unique<World>(m_fixedDt, false);
+
+            //scripts can tell the copies apart, e.g. to try a different tuning value in each
+            world->getLuaSystem().runString("WORLD_INDEX = " + std::to_string(index));
+            if (!world->load(scene)) throw std::runtime_error("Headless: nothing loaded from " + scene);
+
+            m_batchWorlds.push_back(std::move(world));
+        }
+
+        std::cout << "[Headless] " << worlds << " worlds of " << scene << "\n";
+        m_isRunning = true;
+        return;
+    }
+
+    m_world = std::make_unique<World>(m_fixedDt);
+    m_manager = &m_world->getManager();
+    m_inputSystem = std::make_unique<InputSystem>();
+
+    registerSystems();
+
+    //a replay has to start in the scene it was recorded in
+    std::string sceneName = m_recorder.getMode() == InputRecorder::Mode::Replaying ? m_recorder.getScene() : scene;
+    if (!m_world->load(sceneName)) {
+        throw std::runtime_error("Headless: nothing loaded from " + sceneName);
+    }
+
+    if (!m_recordPath.empty()) m_recorder.startRecording(m_recordPath, m_manager->getLoadedScene(), m_fixedDt);
+
+    m_isRunning = true;
+}
+
+bool CoreEngine::ReplayFrom(const std::string& path) {
+    if (!m_recorder.startReplay(path)) return false;
+
+    //the steps only line up with the same step size
+    m_fixedDt = m_recorder.getFixedDt();
+    return true;
+}
+
+int CoreEngine::RunHeadless(int frames) {
+    if (!m_batchWorlds.empty()) return runWorlds(frames);
+
+    const bool replaying = m_recorder.getMode() == InputRecorder::Mode::Replaying;
+
+    //a replay runs for as long as the recording, with its dt and steps
+    m_alpha = 0.0;
+    int ran = 0;
+    long long steps = 0;
+    std::vector<SystemTimer> timerTotals;
+    AllocationStats afterFirstFrame;
+
+    auto start = std::chrono::steady_clock::now();
+    for (; m_isRunning && (replaying || ran < frames); ++ran) {
+        InputHandler::update();
+
+        //one fixed step per frame, no waiting for the clock in between
+        float deltaTime = static_cast<float>(m_fixedDt);
+        m_simSteps = 1;
+        if (m_recorder.isActive() && !m_recorder.beginFrame(deltaTime, m_simSteps)) break;
+
+        m_world->setFrameSteps(m_simSteps);
+        m_scheduler->run(deltaTime);
+        m_manager->playbackCommands();
+        steps += m_simSteps;
+
+        if (m_recorder.isActive()) m_recorder.endFrame(InputRecorder::hashState(*m_manager));
+
+        collectSystemTimers(timerTotals);
+
+        //the first frame fills the caches and scratch buffers, the rest should not touch the heap
+        if (ran == 0) afterFirstFrame = GetAllocationTotals();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const size_t steadyAllocations = ran > 1 ? GetAllocationTotals().allocations - afterFirstFrame.allocations : 0;
+    long long firstDivergence = m_recorder.getFirstDivergence();
+    m_recorder.stop();
+
+    double simulated = steps * m_fixedDt;
+    double fps = seconds > 0.0 ? ran / seconds : 0.0;
+    double speedup = seconds > 0.0 ? simulated / seconds : 0.0;
+
+    std::cout << "[Headless] " << ran << " frames (" << simulated << " s simulated) in "
+        << seconds << " s\n"
+        << "[Headless] " << fps << " simulated fps, " << speedup << "x real time, "
+        << speedup * 60.0 << " simulated minutes per hour\n";
+    for (const SystemTimer& total : timerTotals) {
+        std::cout << "[Headless] " << total.name << ": " << total.ms << " ms total, "
+            << (ran > 0 ? total.ms / ran : 0.0) << " ms per frame\n";
+    }
+    std::cout << "[Headless] " << steadyAllocations << " heap allocations after the first frame ("
+        << (ran > 1 ? static_cast<double>(steadyAllocations) / (ran - 1) : 0.0) << " per frame)\n";
+
+    //CI can fail the run on a replay that no longer matches
+    return (replaying && firstDivergence >= 0) ? 1 : 0;
+}
+
+int CoreEngine::runWorlds(int frames) {
+    const size_t worldCount = m_batchWorlds.size();
+    const size_t threadCount = std::min<size_t>(worldCount, std::max(std::thread::hardware_concurrency(), 1u));
+    const float deltaTime = static_cast<float>(m_fixedDt);
+
+    //each thread takes the next world nobody has run yet and runs all of its frames
+    std::atomic<size_t> nextWorld{ 0 };
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto runWorld = [&]() {
+        for (size_t index = nextWorld++; index < worldCount; index = nextWorld++) {
+            try {
+                for (int frame = 0; frame < frames; ++frame) m_batchWorlds[index]->update(deltaTime, 1);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                return;
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < threadCount; ++thread) threads.emplace_back(runWorld);
+    for (std::thread& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<SystemTimer> timerTotals;
+    collectSystemTimers(timerTotals);
+    if (error) std::rethrow_exception(error);
+
+    //worlds that took the same input end up in the same state, so this is also a quick
+    //check that nothing leaks between them
+    long long steps = 0;
+    std::vector<std::uint64_t> endStates;
+    for (size_t index = 0; index < worldCount; ++index) {
+        steps += m_batchWorlds[index]->getStepCount();
+        endStates.push_back(InputRecorder::hashState(m_batchWorlds[index]->getManager()));
+        std::cout << "[Headless] world " << index << " end state " << std::hex << endStates.back() << std::dec << "\n";
+    }
+    std::sort(endStates.begin(), endStates.end());
+    size_t distinct = std::unique(endStates.begin(), endStates.end()) - endStates.begin();
+
+    double simulated = steps * m_fixedDt;
+    double speedup = seconds > 0.0 ? simulated / seconds : 0.0;
+
+    std::cout << "[Headless] " << worldCount << " worlds x " << frames << " frames on " << threadCount
+        << " threads in " << seconds << " s, " << distinct << " distinct end states\n"
+        << "[Headless] " << simulated << " s simulated in total, " << speedup << "x real time\n";
+    for (const SystemTimer& total : timerTotals) {
+        std::cout << "[Headless] " << total.name << ": " << total.ms << " ms total over all worlds\n";
+    }
+
+    return 0;
+}
+
 void CoreEngine::Run() {
     while (m_isRunning) {
         GameLoop();
@@ -197,7 +407,7 @@ void CoreEngine::GameLoop() {
     }
 
     //--- Update Timing --- 
-     Perf::UpdateTime(m_delta, m_fps, 0.5);
+     Perf::UpdateTime(m_delta, m_fps, 0.5, m_fixedDt, m_simSteps, m_alpha, m_maxSteps);
 #if defined(_DEBUG) || defined(DEBUG)
      // Show FPS only in debug builds
      Perf::UpdateWindowTitle(m_window, m_title, m_fps, true);
@@ -225,6 +435,9 @@ void CoreEngine::Update(float deltaTime) {
     //for pausing
     if (m_isPaused) return; //skip update when paused
 
+    //heap allocations of the previous frame, shown in the performance window
+    MarkAllocationFrame();
+
     InputHandler::update();
     if (InputHandler::isKeyTriggered(GLFW_KEY_F11)) {
         toggleFullscreen();
@@ -247,21 +460,32 @@ void CoreEngine::Update(float deltaTime) {
         m_guiSystem->pauseUpdate(*m_manager);
 	}
 
-    if(!EditorManager::isEditingMode() && !EditorManager::isPaused()) m_luaSystem->update(*m_manager, deltaTime);
-
-    // Update all systems in order
-    m_inputSystem->update(*m_manager, deltaTime, *m_messageBus);
-    m_physicsSystem->update(*m_manager, deltaTime, *m_messageBus);
-    m_collisionSystem->update(*m_manager, deltaTime);
-    m_logicSystem->update(*m_manager, deltaTime);
-    m_tileMapSystem->update(*m_manager);
-    m_renderSystem->update(*m_manager, deltaTime);
-    m_fontSystem->update(*m_manager, m_fps);    
-    m_audioSystem->update(*m_manager, deltaTime);
+    // the simulation only moves while playing, otherwise draw transforms where they are
+    bool simulating = !EditorManager::isEditingMode() && !EditorManager::isPaused();
+    m_renderSystem->setInterpolationAlpha(simulating ? static_cast<float>(m_alpha) : 1.f);
+
+    //--record starts with the first frame a level is playing
+    if (!m_recordPath.empty() && !m_recorder.isActive() && m_guiSystem->getCurrentState() == GameState::PLAYING) {
+        m_recorder.startRecording(m_recordPath, m_manager->getLoadedScene(), m_fixedDt);
+        m_recordPath.clear();
+    }
+
+    //recording saves this frame's input, dt and step count, a replay swaps them for the recorded ones
+    if (m_recorder.isActive()) m_recorder.beginFrame(deltaTime, m_simSteps);
+
+    // Lua, the fixed steps, then the drawing and audio (see registerSystems)
+    m_world->setFrameSteps(m_simSteps);
+    m_scheduler->run(deltaTime);
+
     #ifdef _DEBUG
         m_uiSystem->update(*m_manager);
     #endif
 
+    //sync point: editor deletes, once nothing is holding on to object pointers
+    m_manager->playbackCommands();
+
+    if (m_recorder.isActive()) m_recorder.endFrame(InputRecorder::hashState(*m_manager));
+
     //performance update
     LogSystemTimersEveryInterval(deltaTime,15.0);
 
@@ -281,6 +505,86 @@ void CoreEngine::Update(float deltaTime) {
 
 }
 
+// ============================================================================
+// System Scheduling
+// ============================================================================
+
+/**
+ * @brief Registers the per frame systems around the World's graphs.
+ *
+ * Each system lists the components and shared engine state it reads and writes.
+ * A system waits for every earlier one it conflicts with, the rest overlap on the
+ * JobSystem workers. The "Commands" entries are the command buffer sync points,
+ * they conflict with everything.
+ *
+ * The World adds Lua and Physics -> Collision -> Logic, the latter at the fixed
+ * rate from config.json, 0 to max_steps times a frame. The last step's systems are
+ * nodes of this graph (see World::registerSimulation), so TileMap, which only reads
+ * transforms, runs next to Logic, and Audio runs next to Render and Font.
+ * Everything else runs once a frame with the frame delta, and Render draws the
+ * transforms interpolated between the last two steps.
+ */
+void CoreEngine::registerSystems() {
+    m_scheduler = std::make_unique<SystemScheduler>();
+
+    m_scheduler->addSystem("Input",
+        SystemAccess().write(EngineResource::EditorState).write(EngineResource::MessageBus),
+        SystemThread::Main, [this](float dt) { m_inputSystem->update(*m_manager, dt, m_world->getMessageBus()); });
+
+    //Lua, the steps a slow frame catches up on, then the last step system by system
+    m_world->registerSimulation(*m_scheduler);
+
+    // main thread: a tile texture can still be loading, and the tile editor reads ImGui.
+    // goes in before the hierarchy pass so it only waits for Collision, not Logic
+    if (!m_headless) {
+        m_scheduler->addSystem("TileMap",
+            SystemAccess().read<Transform>().write<TileMap>()
+                .read(EngineResource::EditorState).write(EngineResource::TileBatches),
+            SystemThread::Main, [this](float) { m_tileMapSystem->update(*m_manager); });
+    }
+
+    m_world->registerSimulationEnd(*m_scheduler);
+
+    //sync point: the last step's spawned bullets, added components etc. show up before
+    //anything is drawn
+    m_scheduler->addSystem("Commands", SystemAccess().writeAll(),
+        SystemThread::Main, [this](float) { m_manager->playbackCommands(); });
+
+    //headless stops at the simulation, everything below draws or plays sound
+    if (!m_headless) {
+        //only reads the transforms, but fills in texture handles and the animation frames
+        m_scheduler->addSystem("Render",
+            SystemAccess().read<Transform, StateMachine>().write<Render, Animation>()
+                .read(EngineResource::EditorState).read(EngineResource::TileBatches),
+            SystemThread::Main, [this](float dt) { m_renderSystem->update(*m_manager, dt); });
+
+        m_scheduler->addSystem("Font",
+            SystemAccess().read<FontComponent, Transform>().read(EngineResource::EditorState),
+            SystemThread::Main, [this](float) { m_fontSystem->update(*m_manager, m_fps); });
+
+        m_scheduler->addSystem("Audio",
+            SystemAccess().write<AudioComponent>().write(EngineResource::Audio),
+            SystemThread::Any, [this](float dt) { m_audioSystem->update(*m_manager, dt); });
+    }
+
+    std::cout << "[Scheduler] " << JobSystem::getInstance().getWorkerCount() << " worker threads, "
+        << 1.0 / m_fixedDt << " Hz simulation\n";
+
+    auto printGraph = [](const char* label, const SystemScheduler& scheduler) {
+        for (size_t i = 0; i < scheduler.getSystemCount(); ++i) {
+            std::cout << "[Scheduler] " << label << " " << scheduler.getSystemName(i)
+                << (scheduler.isMainThread(i) ? " (main)" : " (worker)") << " after:";
+            for (size_t dependency : scheduler.getDependencies(i)) {
+                std::cout << " " << scheduler.getSystemName(dependency);
+            }
+            std::cout << "\n";
+        }
+    };
+    printGraph("frame", *m_scheduler);
+    printGraph("world", m_world->getFrameScheduler());
+    printGraph("step ", m_world->getStepScheduler());
+}
+
 // ============================================================================
 // Toggle Fullscreen
 // ============================================================================
@@ -398,10 +702,24 @@ void CoreEngine::toggleFullscreen()
 
 
 void CoreEngine::Shutdown() {
+    //no job may still be running once systems start tearing down
+    JobSystem::getInstance().shutdown();
+    if (m_world) m_world->getLuaSystem().cleanup();
+    m_batchWorlds.clear();
+
+    //flushes a recording, prints how a replay went
+    m_recorder.stop();
+
+    //headless never made a GL context, FMOD or fonts
+    if (m_headless) return;
+
+    //their static batches and the fbo go while there is still a context
+    m_tileMapSystem.reset();
+    m_renderSystem.reset();
+
 	ResourceManager::getInstance().shutdown();
     renderer::cleanup();
     Font::freeFonts();
-    if (m_luaSystem) m_luaSystem->cleanup();
     glfwDestroyWindow(m_window);
     glfwTerminate();
 }
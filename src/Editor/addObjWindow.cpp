@@ -166,7 +166,7 @@ void AddObjWindow::createEmpty(GameObjectManager& manager, float x, float y, flo
     transform->z = z;
 
     // record the create command (for undo)
-    auto cmd = std::make_unique<CreateObjectCmd>(manager, name);
+    auto cmd = std::make_unique<CreateObjectCmd>(manager, obj);
     UndoRedoManager::Instance().executeCmd(std::move(cmd));
 
     DebugLog::addMessage("Empty created at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")\n");
@@ -176,8 +176,11 @@ void AddObjWindow::createRec(GameObjectManager& manager, float x, float y, float
     std::string name = "Rectangle_" + std::to_string(manager.getGameObjectCount());
     GameObject* recobj = manager.createGameObject(name);
 
-    Transform* transform = recobj->addComponent<Transform>();
-    Render* render = recobj->addComponent<Render>();
+    recobj->addComponent<Transform>();
+    recobj->addComponent<Render>();
+    // fetch after both adds, adding a component moves the others
+    Transform* transform = recobj->getComponent<Transform>();
+    Render* render = recobj->getComponent<Render>();
     if (!transform || !render) {
         DebugLog::addMessage("Error creating a game object. Component doesn't exist.");
         return;
@@ -195,7 +198,7 @@ void AddObjWindow::createRec(GameObjectManager& manager, float x, float y, float
     }
 
     // record the create command (for undo)
-    auto cmd = std::make_unique<CreateObjectCmd>(manager, name);
+    auto cmd = std::make_unique<CreateObjectCmd>(manager, recobj);
     UndoRedoManager::Instance().executeCmd(std::move(cmd));
 
     DebugLog::addMessage("Rectangle created at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")\n");
@@ -206,8 +209,11 @@ void AddObjWindow::createCir(GameObjectManager& manager, float x, float y, float
     std::string name = "Circle_" + std::to_string(manager.getGameObjectCount());
     GameObject* circleObj = manager.createGameObject(name);
 
-    Transform* transform = circleObj->addComponent<Transform>();
-    Render* render = circleObj->addComponent<Render>();
+    circleObj->addComponent<Transform>();
+    circleObj->addComponent<Render>();
+    // fetch after both adds, adding a component moves the others
+    Transform* transform = circleObj->getComponent<Transform>();
+    Render* render = circleObj->getComponent<Render>();
     if (!transform || !render) {
         DebugLog::addMessage("Error creating a game object. Component doesn't exist.");
         return;
@@ -220,7 +226,7 @@ void AddObjWindow::createCir(GameObjectManager& manager, float x, float y, float
     transform->z = z;
 
     // record the create command (for undo)
-    auto cmd = std::make_unique<CreateObjectCmd>(manager, name);
+    auto cmd = std::make_unique<CreateObjectCmd>(manager, circleObj);
     UndoRedoManager::Instance().executeCmd(std::move(cmd));
 
     DebugLog::addMessage("Circle created at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")\n");
@@ -236,13 +242,14 @@ void AddObjWindow::dupObj(GameObjectManager& manager, GameObject* oriObj) {
         // add offset from original object
         dupT->x = oriT->x + 1.f;
         dupT->y = oriT->y + 1.f;
+        dupT->markDirty();
     }
 
     // record the create command (for undo)
-    auto cmd = std::make_unique<CreateObjectCmd>(manager, name);
+    auto cmd = std::make_unique<CreateObjectCmd>(manager, dupObj);
     UndoRedoManager::Instance().executeCmd(std::move(cmd));
 
-    Editor::objSelectionState.selectedObject = dupObj;
+    Editor::objSelectionState.selectedObject = dupObj->getHandle();
 
     DebugLog::addMessage("Object duplicated!");
 }
@@ -238,7 +238,7 @@ void AssetBrowser::render() {
                 // set the selected prefab to double clicked prefab, later will show in inspector
                 std::unique_ptr<GameObject> tempPrefab = PrefabManager::Instance().createTempPrefabObj(prefabID);
                 if (tempPrefab) {
-                    m_objSelectionState.selectedObject = nullptr;
+                    m_objSelectionState.selectedObject = EntityHandle{};
                     m_objSelectionState.selectedIndex = -1;
                     m_objSelectionState.selectedPrefab = std::move(tempPrefab);
 
@@ -42,7 +42,7 @@ void EditorManager::update(GameObjectManager& manager) {
     hierarchyWindow.render(manager);
     inspectorWindow.render(manager);
     menuBar.render(manager);
-    performanceWindow.render();
+    performanceWindow.render(manager);
 
     // only show play info when not editing
     if (!isEditing) playDebugWindow.render();
@@ -60,7 +60,7 @@ void EditorManager::handleShortcutKeys(GameObjectManager& manager) {
 
     /* --------------- "Q" -> Deselect Obj --------------- */
     if (InputHandler::isKeyTriggered(GLFW_KEY_Q)) {
-        if (Editor::objSelectionState.selectedObject) {
+        if (manager.isAlive(Editor::objSelectionState.selectedObject)) {
             sceneWindow.resetSelection();
         }
     }
@@ -73,7 +73,7 @@ void EditorManager::handleShortcutKeys(GameObjectManager& manager) {
     /* --------------- END --------------- */
 
     /* --------------- GIZMO CONTROL --------------- */
-    if (Editor::objSelectionState.selectedObject && !ImGuizmo::IsUsing()) {
+    if (manager.isAlive(Editor::objSelectionState.selectedObject) && !ImGuizmo::IsUsing()) {
         if (InputHandler::isKeyTriggered(GLFW_KEY_W)) {
             Editor::gizmoState.currentOp = Editor::GIZMO_TRANSLATE;
         }
@@ -92,7 +92,7 @@ void EditorManager::handleShortcutKeys(GameObjectManager& manager) {
 
     /* --------------- "DEL" -> Delete Game Object --------------- */
     if (InputHandler::isKeyTriggered(GLFW_KEY_DELETE)) {
-        if (Editor::objSelectionState.selectedObject) {
+        if (manager.isAlive(Editor::objSelectionState.selectedObject)) {
             Editor::objSelectionState.showDeletePopup = true;
         }
     }
@@ -102,8 +102,8 @@ void EditorManager::handleShortcutKeys(GameObjectManager& manager) {
     /* --------------- "CTRL" + "D" -> Duplicate Game Object --------------- */
     if (InputHandler::isComboKeyTriggered(GLFW_KEY_D) ||
         InputHandler::isComboKeyTriggered(GLFW_KEY_D, GLFW_KEY_RIGHT_CONTROL)) {
-        if (Editor::objSelectionState.selectedObject) {
-            AddObjWindow::dupObj(manager, Editor::objSelectionState.selectedObject);
+        if (GameObject* selected = manager.getGameObject(Editor::objSelectionState.selectedObject)) {
+            AddObjWindow::dupObj(manager, selected);
         }
     }
     /* --------------- END --------------- */
@@ -26,39 +26,23 @@ void HierarchyWindow::render(GameObjectManager& manager) {
     std::vector<GameObject*> gameObjects;
     manager.getAllGameObjects(gameObjects);
 
-    // by default just set to no children
-    ImGuiTreeNodeFlags baseFlags = ImGuiTreeNodeFlags_Leaf;
-
+    // selection is still stored as the position in this list
+    std::unordered_map<GameObject*, int> indices;
     for (size_t i = 0; i < gameObjects.size(); i++) {
-        // if no children (in the future)
-    //    baseFlags |= ImGuiTreeNodeFlags_Leaf;
-
-        // highlight selected row
-        if (i == m_objSelectionState.selectedIndex) {
-            baseFlags |= ImGuiTreeNodeFlags_Selected;
-        }
-        else {
-            baseFlags &= ~ImGuiTreeNodeFlags_Selected;
-        }
-
-        // draw tree node for each object
-        if (ImGui::TreeNodeEx(gameObjects[i]->getObjectName().c_str(), baseFlags)) {
-            if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
-                m_objSelectionState.selectedIndex = static_cast<int>(i);
-                m_objSelectionState.selectedObject = gameObjects[i];
-            }
-
-            /* ------- right click context menu ------- */
-            showContextMenu(manager, gameObjects[i], static_cast<int>(i));
-
-            ImGui::TreePop();
+        indices[gameObjects[i]] = static_cast<int>(i);
+    }
 
+    // roots here, their children are drawn inside them
+    TransformHierarchy& hierarchy = manager.getHierarchy();
+    for (GameObject* obj : gameObjects) {
+        if (hierarchy.getParent(obj->getHandle()).isNull()) {
+            renderNode(manager, obj, indices);
         }
     }
 
     if (gameObjects.empty()) {
-        m_objSelectionState.selectedObject = nullptr;
-        m_objSelectionState.draggedObject = nullptr;
+        m_objSelectionState.selectedObject = EntityHandle{};
+        m_objSelectionState.draggedObject = EntityHandle{};
         m_objSelectionState.selectedIndex = -1;
 
         ImGui::Text("No GameObjects available");
@@ -81,10 +65,74 @@ void HierarchyWindow::render(GameObjectManager& manager) {
 
     /* ---------- Popup Modal Call --------- */
     objDeletePopup(manager);
-    createPrefabPopup();
+    createPrefabPopup(manager);
     /* ---------- END --------- */
 }
 
+void HierarchyWindow::renderNode(GameObjectManager& manager, GameObject* obj, const std::unordered_map<GameObject*, int>& indices) {
+    const std::vector<EntityHandle>& children = manager.getHierarchy().getChildren(obj->getHandle());
+
+    ImGuiTreeNodeFlags flags = children.empty() ? ImGuiTreeNodeFlags_Leaf : (ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_DefaultOpen);
+
+    // highlight selected row
+    if (obj->getHandle() == m_objSelectionState.selectedObject) {
+        flags |= ImGuiTreeNodeFlags_Selected;
+    }
+
+    int index = indices.at(obj);
+
+    // draw tree node for each object, ids by handle so renaming does not close it
+    ImGui::PushID(static_cast<int>(obj->getHandle().index));
+    bool open = ImGui::TreeNodeEx(obj->getObjectName().c_str(), flags);
+
+    if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
+        m_objSelectionState.selectedIndex = index;
+        m_objSelectionState.selectedObject = obj->getHandle();
+    }
+
+    // drag this row onto another to attach it there
+    if (ImGui::BeginDragDropSource()) {
+        std::uint64_t bits = obj->getHandle().toBits();
+        ImGui::SetDragDropPayload("HIERARCHY_OBJECT", &bits, sizeof(bits));
+        ImGui::Text("%s", obj->getObjectName().c_str());
+        ImGui::EndDragDropSource();
+    }
+    handleReparentDragDrop(manager, obj);
+
+    /* ------- right click context menu ------- */
+    showContextMenu(manager, obj, index);
+
+    if (open) {
+        // copy, the context menu may change the links while we draw
+        std::vector<EntityHandle> childHandles = children;
+        for (EntityHandle child : childHandles) {
+            if (GameObject* childObj = manager.getGameObject(child)) {
+                renderNode(manager, childObj, indices);
+            }
+        }
+
+        ImGui::TreePop();
+    }
+    ImGui::PopID();
+}
+
+void HierarchyWindow::handleReparentDragDrop(GameObjectManager& manager, GameObject* target) {
+    if (ImGui::BeginDragDropTarget()) {
+        if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("HIERARCHY_OBJECT")) {
+            EntityHandle child = EntityHandle::fromBits(*static_cast<const std::uint64_t*>(payload->Data));
+            GameObject* childObj = manager.getGameObject(child);
+
+            if (childObj && manager.getHierarchy().setParent(manager, child, target->getHandle())) {
+                DebugLog::addMessage("Attached " + childObj->getObjectName() + " to " + target->getObjectName() + ".\n");
+            }
+            else {
+                DebugLog::addMessage("Cannot attach an object to itself or to one of its children.\n");
+            }
+        }
+        ImGui::EndDragDropTarget();
+    }
+}
+
 void HierarchyWindow::handlePrefabDragDrop(GameObjectManager& manager) {
     // receive prefab and make it into a game obj referecing the prefab
     if (ImGui::BeginDragDropTarget()) {
@@ -133,9 +181,14 @@ void HierarchyWindow::showContextMenu(GameObjectManager& manager, GameObject* ob
             AddObjWindow::dupObj(manager, obj);
         }
 
+        if (!manager.getHierarchy().getParent(obj->getHandle()).isNull() && ImGui::MenuItem("Detach from Parent")) {
+            manager.getHierarchy().setParent(manager, obj->getHandle(), EntityHandle{});
+            DebugLog::addMessage("Detached " + obj->getObjectName() + ".\n");
+        }
+
         if (ImGui::MenuItem("Delete Object")) {
             m_objSelectionState.selectedIndex = objIndex;
-            m_objSelectionState.selectedObject = obj;
+            m_objSelectionState.selectedObject = obj->getHandle();
             m_objSelectionState.showDeletePopup = true;
         }
 
@@ -145,7 +198,7 @@ void HierarchyWindow::showContextMenu(GameObjectManager& manager, GameObject* ob
 
         if (ImGui::MenuItem("Save as Prefab")) {
             m_objSelectionState.selectedIndex = objIndex;
-            m_objSelectionState.selectedObject = obj;
+            m_objSelectionState.selectedObject = obj->getHandle();
             m_objSelectionState.showCreatePrefabPopup = true;
         }
 
@@ -154,7 +207,7 @@ void HierarchyWindow::showContextMenu(GameObjectManager& manager, GameObject* ob
             if (ImGui::MenuItem("Edit Prefab")) {
                 std::unique_ptr<GameObject> tempPrefab = PrefabManager::Instance().createTempPrefabObj(obj->getObjectPrefabID());
                 if (tempPrefab) {
-                    m_objSelectionState.selectedObject = nullptr;
+                    m_objSelectionState.selectedObject = EntityHandle{};
                     m_objSelectionState.selectedIndex = -1;
                     m_objSelectionState.selectedPrefab = std::move(tempPrefab);
 
@@ -210,19 +263,22 @@ void HierarchyWindow::objDeletePopup(GameObjectManager& manager) {
         ImGui::Text("Are you sure you want to delete this object?");
 
         if (ImGui::Button("Delete") || InputHandler::isKeyTriggered(GLFW_KEY_ENTER)) {
-            std::string name = m_objSelectionState.selectedObject->getObjectName();
+            // selection may have been deleted by something else while the popup was open
+            if (GameObject* selected = manager.getGameObject(m_objSelectionState.selectedObject)) {
+                std::string name = selected->getObjectName();
 
-            //manager.deleteGameObject(m_objSelectionState.selectedObject); -> CREATE DELETE CMD will handle the deletion
+                //manager.deleteGameObject(m_objSelectionState.selectedObject); -> CREATE DELETE CMD will handle the deletion
 
-            // call CREATE DELETE CMD to settle the deletion, and save in a stack (for undo)
-            auto cmd = std::make_unique<DeleteObjCmd>(manager, m_objSelectionState.selectedObject);
-            UndoRedoManager::Instance().executeCmd(std::move(cmd));
+                // call CREATE DELETE CMD to settle the deletion, and save in a stack (for undo)
+                auto cmd = std::make_unique<DeleteObjCmd>(manager, selected);
+                UndoRedoManager::Instance().executeCmd(std::move(cmd));
 
-            m_objSelectionState.selectedObject = nullptr;
-            m_objSelectionState.draggedObject = nullptr;
-            m_objSelectionState.selectedIndex = -1;
+                DebugLog::addMessage("Object " + name + " deleted\n");
+            }
 
-            DebugLog::addMessage("Object " + name + " deleted\n");
+            m_objSelectionState.selectedObject = EntityHandle{};
+            m_objSelectionState.draggedObject = EntityHandle{};
+            m_objSelectionState.selectedIndex = -1;
 
             ImGui::CloseCurrentPopup();
         }
@@ -237,7 +293,7 @@ void HierarchyWindow::objDeletePopup(GameObjectManager& manager) {
     }
 }
 
-void HierarchyWindow::createPrefabPopup() {
+void HierarchyWindow::createPrefabPopup(GameObjectManager& manager) {
     // open popup if flagged
     if (m_objSelectionState.showCreatePrefabPopup) {
         ImGui::OpenPopup("Confirm Create Prefab");
@@ -254,7 +310,7 @@ void HierarchyWindow::createPrefabPopup() {
 
         if (ImGui::Button("Create and Pack")) {
 
-            if (PrefabManager::Instance().createPrefabFromGameObj(m_objSelectionState.selectedObject, "", true))
+            if (PrefabManager::Instance().createPrefabFromGameObj(manager.getGameObject(m_objSelectionState.selectedObject), "", true))
                 DebugLog::addMessage("Prefab created.\n");
             else DebugLog::addMessage("Prefab not created.\n");
 
@@ -267,7 +323,7 @@ void HierarchyWindow::createPrefabPopup() {
 
         if (ImGui::Button("Create but Do Not Pack")) {
 
-            if (PrefabManager::Instance().createPrefabFromGameObj(m_objSelectionState.selectedObject))
+            if (PrefabManager::Instance().createPrefabFromGameObj(manager.getGameObject(m_objSelectionState.selectedObject)))
                 DebugLog::addMessage("Prefab created.\n");
             else DebugLog::addMessage("Prefab not created.\n");
 
@@ -25,8 +25,9 @@ InspectorWindow::InspectorWindow(Editor::ObjSelectionState& Ostate, Editor::Gizm
 void InspectorWindow::render(GameObjectManager& manager) {
     ImGui::Begin("Inspector");
 
+    GameObject* selectedObj = manager.getGameObject(m_objSelectionState.selectedObject);
     GameObject* selected = nullptr;
-    if (m_objSelectionState.selectedObject) selected = m_objSelectionState.selectedObject;
+    if (selectedObj) selected = selectedObj;
     else if (m_objSelectionState.selectedPrefab) {
         selected = m_objSelectionState.selectedPrefab.get();
 
@@ -66,14 +67,11 @@ void InspectorWindow::render(GameObjectManager& manager) {
 
             // ENTER to apply name change
             if (ImGui::InputText("##Name", buffer, sizeof(buffer), ImGuiInputTextFlags_EnterReturnsTrue)) {
-                std::string oldObjName = objName;
                 std::string newObjName = buffer;
 
-                if (selected == m_objSelectionState.selectedObject) {
-                    if (manager.renameGameObject(m_objSelectionState.selectedObject, newObjName)) {
-                        // update obj new name jic redo/undo
-                        UndoRedoManager::Instance().updateObjName(oldObjName, newObjName);
-
+                if (selected == selectedObj) {
+                    // undo/redo goes by handle, so renaming does not affect it
+                    if (manager.renameGameObject(selectedObj, newObjName)) {
                         DebugLog::addMessage("Object renamed to " + newObjName + "\n");
                     }
                     else {
@@ -97,7 +95,7 @@ void InspectorWindow::render(GameObjectManager& manager) {
 
         /* ------------------- Object Transformation ------------------- */
         if (selected->hasComponent<Transform>()) {
-            if (selected == m_objSelectionState.selectedObject) renderGizmoCtrl();
+            if (selected == selectedObj) renderGizmoCtrl();
 
 
             ImGui::Spacing();
@@ -216,8 +214,8 @@ void InspectorWindow::render(GameObjectManager& manager) {
     else {
         ImGui::Text("No object selected");
 
-        m_objSelectionState.selectedObject = nullptr;
-        m_objSelectionState.draggedObject = nullptr;
+        m_objSelectionState.selectedObject = EntityHandle{};
+        m_objSelectionState.draggedObject = EntityHandle{};
         m_objSelectionState.selectedPrefab = nullptr;
         m_objSelectionState.selectedIndex = -1;
     }
@@ -319,6 +317,10 @@ void InspectorWindow::renderTransform(GameObject* selected) {
     CollisionInfo* collision = selected->getComponent<CollisionInfo>();
 
     if (ImGui::CollapsingHeader("Transform")) {
+        // the widgets below write straight into the fields. only bump the version when one of
+        // them changed something, a child that is just being looked at must keep following its parent
+        const float before[] = { transform->x, transform->y, transform->z, transform->rotation,
+            transform->scaleX, transform->scaleY, transform->scaleZ };
 
         if (ImGui::TreeNode("Position")) {
             ImGui::DragFloat("X", &transform->x, 0.1f);
@@ -384,6 +386,10 @@ void InspectorWindow::renderTransform(GameObject* selected) {
 
             ImGui::TreePop();
         }
+
+        const float after[] = { transform->x, transform->y, transform->z, transform->rotation,
+            transform->scaleX, transform->scaleY, transform->scaleZ };
+        if (!std::equal(std::begin(before), std::end(before), std::begin(after))) transform->markDirty();
     }
 }
 
@@ -479,6 +485,10 @@ void InspectorWindow::renderRender( GameObject* selected) {
             ImGui::EndDisabled();
             ImGui::TreePop();
         }
+
+        // backgrounds and other scenery that never move, drawn from a static batch
+        // that is only rebuilt when they are edited. textured, unanimated objects only
+        ImGui::Checkbox("Static", &render->isStatic);
         
      
         ImGui::Spacing();
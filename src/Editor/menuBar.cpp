@@ -172,8 +172,8 @@ void MenuBar::stopSimulation(GameObjectManager& manager) {
     UndoRedoManager::Instance().clear();
 
 
-    m_objSelectionState.selectedObject = nullptr;
-    m_objSelectionState.draggedObject = nullptr;
+    m_objSelectionState.selectedObject = EntityHandle{};
+    m_objSelectionState.draggedObject = EntityHandle{};
     m_objSelectionState.selectedPrefab = nullptr;
     m_objSelectionState.selectedIndex = -1;
 
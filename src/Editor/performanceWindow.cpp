@@ -16,14 +16,47 @@ Technology is prohibited.
 /* End Header **************************************************************************/
 #ifdef _DEBUG
 #include "Editor/editorManager.h"
+#include "renderer.h"
+#include "Systems.h"
 
-void PerformanceWindow::render(){
+void PerformanceWindow::render(GameObjectManager& manager){
     ImGui::Begin("Performance");
     //time frame:
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
         1000.0f / ImGui::GetIO().Framerate,
         ImGui::GetIO().Framerate);
     ImGui::Separator();
+    //memory: a steady state frame should not be touching the heap at all
+    ImGui::Text("Heap allocs last frame: %zu (%zu bytes), frees: %zu",
+        g_FrameAllocations.allocations, g_FrameAllocations.bytes, g_FrameAllocations.frees);
+    const ChunkPool& chunkPool = manager.getStorage().getChunkPool();
+    ImGui::Text("Objects: %d / %zu pooled, chunks: %zu allocated (%zu free)",
+        manager.getGameObjectCount(), manager.getObjectPoolCapacity(),
+        chunkPool.getAllocatedCount(), chunkPool.getFreeCount());
+    ImGui::Separator();
+    //instancing: the ring grows on its own, this shows how close a level gets
+    const renderer::InstanceStats& instances = renderer::instanceStats;
+    ImGui::Text("Instances: %d in %d batches, largest batch %d",
+        instances.frameInstances, instances.frameBatches, instances.largestBatch);
+    ImGui::Text("Draw calls: %d (%d without multi draw)", instances.frameDrawCalls, instances.frameBatches);
+    ImGui::Text("Peak: %d per batch, %d per frame, ring %d per frame (grown %d times)",
+        instances.peakBatch, instances.peakFrame, renderer::instanceRing.regionInstances, instances.grows);
+    //static batches stay on the GPU, nothing of theirs goes through the ring
+    ImGui::Text("Static: %d batches, %d instances (built %d times)",
+        instances.frameStaticBatches, instances.frameStaticInstances, instances.staticBuilds);
+    //culling: what the camera could not see never got batched
+    const RenderSystem::CullStats& culling = RenderSystem::cullStats;
+    ImGui::Text("Objects: %zu drawn, %zu culled (%zu reindexed)",
+        culling.objectsVisible, culling.objectsCulled, culling.objectsReindexed);
+    ImGui::Text("Tiles: %zu drawn, %zu culled", culling.tilesVisible, culling.tilesCulled);
+    //sorted render queue: fewer runs than items means draws were merged
+    const RenderSystem::QueueStats& queue = RenderSystem::queueStats;
+    ImGui::Text("Queue: %zu items in %zu runs, %zu layers, %zu program switches",
+        queue.items, queue.runs, queue.layers, queue.programSwitches);
+    //text: glyphs are instanced out of one atlas per font
+    const FontSystem::TextStats& text = FontSystem::textStats;
+    ImGui::Text("Text: %zu glyphs in %zu draws", text.glyphs, text.drawCalls);
+    ImGui::Separator();
     //average time --can add for other functions also just need to add 4 lines of codes into the function start and end(see InputSystem::Update in system.cpp)
     double totalMs = 0.0;
     for (auto& timer : g_SystemTimers) totalMs += timer.ms;
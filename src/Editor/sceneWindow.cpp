@@ -84,12 +84,13 @@ void SceneWindow::render(GLuint texture, float aspectRatio, GameObjectManager& m
 
         // drag to reposition obj
         if (InputHandler::isMouseDragging() && !ImGuizmo::IsUsing()) {
-            objDragging();
+            objDragging(manager);
         }
 
         if (InputHandler::isMouseLeftReleased()) {
-            if (UndoRedoManager::Instance().isEditingTransform() && m_objSelectionState.draggedObject) {
-                UndoRedoManager::Instance().endTransformEdit(manager, m_objSelectionState.draggedObject);
+            GameObject* dragged = manager.getGameObject(m_objSelectionState.draggedObject);
+            if (UndoRedoManager::Instance().isEditingTransform() && dragged) {
+                UndoRedoManager::Instance().endTransformEdit(manager, dragged);
             }
         }
 
@@ -119,10 +120,10 @@ void SceneWindow::render(GLuint texture, float aspectRatio, GameObjectManager& m
 
 void SceneWindow::renderGizmo(GameObjectManager& manager) {
     // early return if no obj selected OR playing simulation OR gizmo is off
-    if (!m_objSelectionState.selectedObject || !EditorManager::isEditingMode()) return;
+    GameObject* selected = manager.getGameObject(m_objSelectionState.selectedObject);
+    if (!selected || !EditorManager::isEditingMode()) return;
     if (m_gizmoState.currentOp == Editor::GIZMO_NONE) return;
 
-    GameObject* selected = m_objSelectionState.selectedObject;
     Transform* t = selected->getComponent<Transform>();
     if (!t) return;
 
@@ -205,6 +206,7 @@ void SceneWindow::renderGizmo(GameObjectManager& manager) {
         t->scaleX = scale.x;
         t->scaleY = scale.y;
         t->scaleZ = scale.z;
+        t->markDirty();
 
         // if collider size set to auto-fit, update its size to match mesh size
         if (CollisionInfo* collision = selected->getComponent<CollisionInfo>()) {
@@ -239,7 +241,7 @@ void SceneWindow::drawGrid(const glm::mat4& view, const glm::mat4& proj, GameObj
 
     for (GameObject* obj : gameObjects)
     {
-        if (!obj->hasComponent<TileMap>() || !obj->hasComponent<Transform>())
+        if (!obj->hasComponents<TileMap, Transform>())
             continue;
 
         TileMap* tm = obj->getComponent<TileMap>();
@@ -631,8 +633,8 @@ void SceneWindow::objPicking(GameObjectManager& manager) {
     // if something is selected, update selection state
     if (selected) {
         m_objSelectionState.selectedPrefab = nullptr;
-        m_objSelectionState.selectedObject = selected;
-        m_objSelectionState.draggedObject = selected;
+        m_objSelectionState.selectedObject = selected->getHandle();
+        m_objSelectionState.draggedObject = selected->getHandle();
 
         UndoRedoManager::Instance().beginTransformEdit(selected);
 
@@ -645,13 +647,13 @@ void SceneWindow::objPicking(GameObjectManager& manager) {
     }
     else {
         // if mouse click somewhere else, deselect current dragged object
-        m_objSelectionState.draggedObject = nullptr;
+        m_objSelectionState.draggedObject = EntityHandle{};
     }
 }
 
-void SceneWindow::objDragging() const {
-    // early return if no obj is selected
-    GameObject* obj = m_objSelectionState.draggedObject;
+void SceneWindow::objDragging(GameObjectManager& manager) const {
+    // early return if no obj is selected (or it was deleted)
+    GameObject* obj = manager.getGameObject(m_objSelectionState.draggedObject);
     if (!obj) return;
 
     Transform* transform = obj->getComponent<Transform>();
@@ -661,6 +663,7 @@ void SceneWindow::objDragging() const {
     Vector2D mousePos = InputHandler::getMouseDeltaWorldInViewport(m_sceneWindowState.sceneSize);
     transform->x += mousePos.x;
     transform->y += mousePos.y;
+    transform->markDirty();
 
     // if obj has physics, do not follow gravity while dragging
     Physics* physics = obj->getComponent<Physics>();
@@ -670,8 +673,8 @@ void SceneWindow::objDragging() const {
 }
 
 void SceneWindow::resetSelection() {
-    m_objSelectionState.selectedObject = nullptr;
-    m_objSelectionState.draggedObject = nullptr;
+    m_objSelectionState.selectedObject = EntityHandle{};
+    m_objSelectionState.draggedObject = EntityHandle{};
     m_objSelectionState.selectedPrefab = nullptr;
     m_objSelectionState.selectedIndex = -1;
 }
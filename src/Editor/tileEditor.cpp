@@ -15,7 +15,42 @@ Technology is prohibited.
 /* End Header **************************************************************************/
 
 #include "Systems.h"
-std::unordered_map<BatchKey, std::vector<renderer::InstanceData>, BatchKeyHash> RenderSystem::objectWithTex2{};
+
+#include <algorithm>
+#include <cmath>
+std::vector<RenderSystem::StaticDraw> RenderSystem::visibleTileBatches{};
+
+namespace
+{
+	using ChunkGroups = std::unordered_map<BatchKey, std::vector<renderer::InstanceData>, BatchKeyHash>;
+
+	//tile (x, y) covers [originX + x * tileW, originX + (x + 1) * tileW), same for y
+	void addTile(ChunkGroups& groups, float originX, float originY, float z, const TileMap& tileMap, const TileMap::TileKey& tileKey, const std::string& tileID)
+	{
+		TextureData texture = ResourceManager::getInstance().getTexture(tileID);
+		if (!texture.array) return;
+
+		renderer::InstanceData data; //default texParams, no slicing
+		data.setTransform(originX + tileKey.x * tileMap.tileW + tileMap.tileW * 0.5f, originY + tileKey.y * tileMap.tileH + tileMap.tileH * 0.5f, z, 0.f, tileMap.tileW, tileMap.tileH);
+		data.setColor(glm::vec4(0, 0, 0, 1));
+		data.texLayer = static_cast<GLushort>(texture.layer);
+		groups[BatchKey{ shape::square, texture.array }].push_back(data);
+	}
+
+	SpatialGrid::Rect chunkBounds(float originX, float originY, const TileMap& tileMap, const TileMap::TileKey& chunkKey)
+	{
+		const float chunkW = TileMapSystem::CHUNK_TILES * tileMap.tileW;
+		const float chunkH = TileMapSystem::CHUNK_TILES * tileMap.tileH;
+		return { originX + chunkKey.x * chunkW, originY + chunkKey.y * chunkH, originX + (chunkKey.x + 1) * chunkW, originY + (chunkKey.y + 1) * chunkH };
+	}
+}
+
+TileMapSystem::~TileMapSystem()
+{
+	for (auto& [index, batches] : m_maps)
+		for (auto& [chunkKey, chunk] : batches.chunks)
+			renderer::destroy_static_batch(chunk.batch);
+}
 
 void TileMapSystem::tileUpdate(GameObject* obj)
 {
@@ -31,28 +66,37 @@ void TileMapSystem::tileUpdate(GameObject* obj)
 			if (col >= -tm->columns && col < tm->columns &&
 				row >= -tm->rows && row < tm->rows)
 			{
+				std::uint32_t revision = tm->revision;
+
 				// apply selected tile
 				if (tm->getTile(col, row) != filename)
 					tm->setTile(col, row, filename);
 				else
 					tm->clearTile(col, row);
 
+				//only the chunk under the mouse is rebuilt, unless something else changed the map too
+				auto it = m_maps.find(obj->getHandle().index);
+				if (it != m_maps.end() && it->second.built && it->second.handle == obj->getHandle() && it->second.revision == revision)
+				{
+					it->second.revision = tm->revision;
+					it->second.chunks[chunkOf(col, row)].dirty = true;
+				}
 			}
 #endif
 }
 
 void TileMapSystem::update(GameObjectManager& manager)
 {
-	std::vector<GameObject*> objects;
-	manager.getAllGameObjects(objects);
-	RenderSystem::objectWithTex2.clear();
-	
+	RenderSystem::visibleTileBatches.clear();
+	RenderSystem::cullStats.tilesVisible = 0;
+	RenderSystem::cullStats.tilesCulled = 0;
+	++m_frame;
+
+	SpatialGrid::Rect viewRect = RenderSystem::viewRect(RenderSystem::activeCamera());
 	
-	for (GameObject* obj : objects)
+	manager.each<TileMap, Transform>([this, &viewRect](GameObject& object, TileMap& tileMap, Transform& transformRef)
 	{
-		if (!obj->hasComponent<TileMap>() || !obj->hasComponent<Transform>())
-			continue;
-
+		GameObject* obj = &object;
 
 		if (InputHandler::isMouseLeftClicked())
 		{
@@ -62,21 +106,110 @@ void TileMapSystem::update(GameObjectManager& manager)
 			tileUpdate(obj);
 		}
 
-		TileMap* tm = obj->getComponent<TileMap>();
-		Transform* transform = obj->getComponent<Transform>(); //assume that all objects has transform
+		TileMapBatches& batches = m_maps[object.getHandle().index];
+		if (batches.handle != object.getHandle())
+		{
+			//a new tile map in a reused slot, nothing of the old one's fits
+			for (auto& [chunkKey, chunk] : batches.chunks) renderer::destroy_static_batch(chunk.batch);
+			batches = TileMapBatches{};
+			batches.handle = object.getHandle();
+		}
+		batches.seenFrame = m_frame;
+		updateChunks(batches, tileMap, transformRef);
 
-		for (const auto& [tileKey, tileID] : tm->tiles)
+		//whole chunks in or out of view, the GPU clips the tiles at the edges
+		for (auto& [chunkKey, chunk] : batches.chunks)
 		{
-			renderer::InstanceData data;
-			glm::vec3 pos{ transform->x + tileKey.x * tm->tileW + tm->tileW * 0.5f, transform->y + tileKey.y * tm->tileH + tm->tileH * 0.5f, transform->z };
-			glm::mat4 mdl{ 1 };
-			mdl = glm::translate(mdl, pos);
-			mdl = glm::scale(mdl, glm::vec3(tm->tileW, tm->tileH, 1.f));
-			data.model = mdl;
-			data.color = glm::vec4(0, 0, 0, 1);
-			data.texParams = glm::vec4(0, 0, 1, 1); //no slicing
-			TextureData texID = ResourceManager::getInstance().getTexture(tileID);
-			RenderSystem::objectWithTex2[BatchKey{ shape::square, texID.id }].push_back(data);
+			if (!chunk.batch.vao) continue;
+			if (chunk.bounds.overlaps(viewRect))
+			{
+				RenderSystem::visibleTileBatches.push_back(RenderSystem::StaticDraw{ &chunk.batch, object.getLayer(), transformRef.z });
+				RenderSystem::cullStats.tilesVisible += chunk.tileCount;
+			}
+			else
+			{
+				RenderSystem::cullStats.tilesCulled += chunk.tileCount;
+			}
 		}
+	});
+
+	//tile maps that were deleted (or lost a component) take their batches with them
+	for (auto it = m_maps.begin(); it != m_maps.end();)
+	{
+		if (it->second.seenFrame == m_frame) { ++it; continue; }
+		for (auto& [chunkKey, chunk] : it->second.chunks) renderer::destroy_static_batch(chunk.batch);
+		it = m_maps.erase(it);
 	}
-}
\ No newline at end of file
+}
+
+void TileMapSystem::updateChunks(TileMapBatches& batches, const TileMap& tileMap, const Transform& transform)
+{
+	bool moved = batches.x != transform.x || batches.y != transform.y || batches.z != transform.z
+		|| batches.tileW != tileMap.tileW || batches.tileH != tileMap.tileH;
+
+	if (batches.built && !moved && batches.revision == tileMap.revision)
+	{
+		for (auto& [chunkKey, chunk] : batches.chunks)
+			if (chunk.dirty) buildChunk(batches, chunkKey, chunk, tileMap);
+		return;
+	}
+
+	batches.x = transform.x;
+	batches.y = transform.y;
+	batches.z = transform.z;
+	batches.tileW = tileMap.tileW;
+	batches.tileH = tileMap.tileH;
+	batches.revision = tileMap.revision;
+	batches.built = true;
+
+	//everything again, one pass over the tiles sorts them into their chunks
+	std::unordered_map<TileMap::TileKey, ChunkGroups, TileMap::TileKeyHash> groups;
+	std::unordered_map<TileMap::TileKey, size_t, TileMap::TileKeyHash> counts;
+	for (const auto& [tileKey, tileID] : tileMap.tiles)
+	{
+		TileMap::TileKey chunkKey = chunkOf(tileKey.x, tileKey.y);
+		addTile(groups[chunkKey], batches.x, batches.y, batches.z, tileMap, tileKey, tileID);
+		++counts[chunkKey];
+	}
+
+	for (auto& [chunkKey, chunk] : batches.chunks) renderer::destroy_static_batch(chunk.batch);
+	batches.chunks.clear();
+
+	for (auto& [chunkKey, chunkGroups] : groups)
+	{
+		TileChunk& chunk = batches.chunks[chunkKey];
+		renderer::build_static_batch(chunk.batch, chunkGroups);
+		chunk.tileCount = counts[chunkKey];
+		chunk.bounds = chunkBounds(batches.x, batches.y, tileMap, chunkKey);
+		chunk.dirty = false;
+	}
+}
+
+void TileMapSystem::buildChunk(TileMapBatches& batches, const TileMap::TileKey& chunkKey, TileChunk& chunk, const TileMap& tileMap)
+{
+	ChunkGroups groups;
+	chunk.tileCount = 0;
+
+	//the chunk's cells, fewer lookups than going over the whole map
+	for (int row = chunkKey.y * CHUNK_TILES; row < (chunkKey.y + 1) * CHUNK_TILES; ++row)
+	{
+		for (int col = chunkKey.x * CHUNK_TILES; col < (chunkKey.x + 1) * CHUNK_TILES; ++col)
+		{
+			auto it = tileMap.tiles.find(TileMap::TileKey{ col, row });
+			if (it == tileMap.tiles.end()) continue;
+			addTile(groups, batches.x, batches.y, batches.z, tileMap, it->first, it->second);
+			++chunk.tileCount;
+		}
+	}
+
+	renderer::build_static_batch(chunk.batch, groups);
+	chunk.bounds = chunkBounds(batches.x, batches.y, tileMap, chunkKey);
+	chunk.dirty = false;
+}
+
+TileMap::TileKey TileMapSystem::chunkOf(int x, int y)
+{
+	//floor division, tiles go negative
+	auto floorDiv = [](int value) { return value >= 0 ? value / CHUNK_TILES : -((-value + CHUNK_TILES - 1) / CHUNK_TILES); };
+	return TileMap::TileKey{ floorDiv(x), floorDiv(y) };
+}
@@ -39,8 +39,8 @@ TransformSnapshot captureTransform(GameObject* obj) {
     return snap;
 }
 
-TransformCmd::TransformCmd(GameObjectManager& manager, const std::string& objName, const TransformSnapshot& before, const TransformSnapshot& after)
-    : m_manager(manager), m_objectName(objName), m_before(before), m_after(after) {
+TransformCmd::TransformCmd(GameObjectManager& manager, EntityHandle handle, const TransformSnapshot& before, const TransformSnapshot& after)
+    : m_manager(manager), m_handle(handle), m_before(before), m_after(after) {
 }
 
 void TransformCmd::execute() {
@@ -52,7 +52,7 @@ void TransformCmd::undo() {
 }
 
 void TransformCmd::applySnapshot(const TransformSnapshot& snap) {
-    GameObject* obj = m_manager.getGameObject(m_objectName);
+    GameObject* obj = m_manager.getGameObject(m_handle);
     if (!obj) return;
 
     Transform* t = obj->getComponent<Transform>();
@@ -66,22 +66,23 @@ void TransformCmd::applySnapshot(const TransformSnapshot& snap) {
         t->scaleX = snap.scaleX;
         t->scaleY = snap.scaleY;
         t->scaleZ = snap.scaleZ;
+        t->markDirty();
     }
 }
 
-void TransformCmd::updateObjName(const std::string& oldName, const std::string& newName) {
-    if (m_objectName == oldName) {
-        m_objectName = newName;
+void TransformCmd::remapHandle(EntityHandle oldHandle, EntityHandle newHandle) {
+    if (m_handle == oldHandle) {
+        m_handle = newHandle;
     }
 }
 
-CreateObjectCmd::CreateObjectCmd(GameObjectManager& manager, const std::string& objName)
-    : m_manager(manager), m_objectName(objName) {}
+CreateObjectCmd::CreateObjectCmd(GameObjectManager& manager, GameObject* obj)
+    : m_manager(manager), m_handle(obj ? obj->getHandle() : EntityHandle{}) {}
 
 void CreateObjectCmd::execute() {
     // when creating new object
     if (!m_wasExecuted) {
-        GameObject* obj = m_manager.getGameObject(m_objectName);
+        GameObject* obj = m_manager.getGameObject(m_handle);
     
         if (obj) {
             // serialize current state of obj to a json string (to store all its component)
@@ -91,45 +92,47 @@ void CreateObjectCmd::execute() {
     }
     else {
         if (!m_serializedData.empty()) {
-            // deserialize json string to recreate the gameobject
+            // deserialize json string to recreate the gameobject (name is part of the data)
             GameObject* obj = JsonIO::deserializeGameObj(m_manager, m_serializedData);
 
-            if (obj) obj->getObjectName() = m_objectName;
+            // recreated obj has a new handle, older commands still point at the old one
+            if (obj) {
+                EntityHandle oldHandle = m_handle;
+                m_handle = obj->getHandle();
+                UndoRedoManager::Instance().remapHandle(oldHandle, m_handle);
+            }
         }
     }
 }
 
 void CreateObjectCmd::undo() {
-    GameObject* obj = m_manager.getGameObject(m_objectName);
+    GameObject* obj = m_manager.getGameObject(m_handle);
     if (obj) {
         m_serializedData = JsonIO::serializeGameObj(obj);
 
         // reset selection if deleting the obj (to undo creation)
-        if (Editor::objSelectionState.selectedObject == obj) {
-            Editor::objSelectionState.selectedObject = nullptr;
-            Editor::objSelectionState.draggedObject = nullptr;
+        if (Editor::objSelectionState.selectedObject == m_handle) {
+            Editor::objSelectionState.selectedObject = EntityHandle{};
+            Editor::objSelectionState.draggedObject = EntityHandle{};
             Editor::objSelectionState.selectedIndex = -1;
         }
 
-        // delete the obj (to undo create)
-        m_manager.deleteGameObject(obj);
+        // delete the obj (to undo create), at the end of frame sync point so the
+        // other editor windows can still use it for the rest of this frame
+        m_manager.getCommandBuffer().destroy(m_handle);
     }
 }
 
-void CreateObjectCmd::updateObjName(const std::string& oldName, const std::string& newName) {
-    if (m_objectName == oldName) {
-        m_objectName = newName;
-
-        if (GameObject* obj = m_manager.getGameObject(m_objectName)) {
-            m_serializedData = JsonIO::serializeGameObj(obj);
-        }
+void CreateObjectCmd::remapHandle(EntityHandle oldHandle, EntityHandle newHandle) {
+    if (m_handle == oldHandle) {
+        m_handle = newHandle;
     }
 }
 
 
 DeleteObjCmd::DeleteObjCmd(GameObjectManager& manager, GameObject* obj) : m_manager(manager) {
     if (obj) {
-        m_objectName = obj->getObjectName();
+        m_handle = obj->getHandle();
         m_layer = obj->getLayer();
 
         // save the final state before delete
@@ -138,13 +141,13 @@ DeleteObjCmd::DeleteObjCmd(GameObjectManager& manager, GameObject* obj) : m_mana
 }
 
 void DeleteObjCmd::execute() {
-    GameObject* obj = m_manager.getGameObject(m_objectName);
+    GameObject* obj = m_manager.getGameObject(m_handle);
     if (obj) {
         // serialize the obj to store its component data
         m_serializedData = JsonIO::serializeGameObj(obj);
 
-        // remove the obj
-        m_manager.deleteGameObject(obj);
+        // remove the obj, deferred to the end of frame sync point like undoing a create
+        m_manager.getCommandBuffer().destroy(m_handle);
     }
 }
 
@@ -153,15 +156,19 @@ void DeleteObjCmd::undo() {
         // create a obj from the stored component data
         GameObject* ori = JsonIO::deserializeGameObj(m_manager, m_serializedData);
         if (ori) {
-            ori->getObjectName() = m_objectName;
             m_manager.assignObjectToLayer(ori, m_layer);
+
+            // recreated obj has a new handle, older commands still point at the old one
+            EntityHandle oldHandle = m_handle;
+            m_handle = ori->getHandle();
+            UndoRedoManager::Instance().remapHandle(oldHandle, m_handle);
         }
     }
 }
 
-void DeleteObjCmd::updateObjName(const std::string& oldName, const std::string& newName) {
-    if (m_objectName == oldName) {
-        m_objectName = newName;
+void DeleteObjCmd::remapHandle(EntityHandle oldHandle, EntityHandle newHandle) {
+    if (m_handle == oldHandle) {
+        m_handle = newHandle;
     }
 }
 
@@ -181,13 +188,13 @@ void UndoRedoManager::executeCmd(std::unique_ptr<CmdInterface> cmd) {
     }
 }
 
-void UndoRedoManager::updateObjName(const std::string& oldName, const std::string& newName) {
+void UndoRedoManager::remapHandle(EntityHandle oldHandle, EntityHandle newHandle) {
     for (std::unique_ptr<CmdInterface>& cmd : m_undoDeque) {
-        cmd->updateObjName(oldName, newName);
+        cmd->remapHandle(oldHandle, newHandle);
     }
 
     for (std::unique_ptr<CmdInterface>& cmd : m_redoDeque) {
-        cmd->updateObjName(oldName, newName);
+        cmd->remapHandle(oldHandle, newHandle);
     }
 }
 
@@ -227,7 +234,7 @@ void UndoRedoManager::beginTransformEdit(GameObject* obj) {
     if (!obj || m_isEditingTransform) return;
 
     m_isEditingTransform = true;
-    m_editingObjName = obj->getObjectName();
+    m_editingHandle = obj->getHandle();
     m_transformBefore = captureTransform(obj);
 }
 
@@ -237,7 +244,7 @@ void UndoRedoManager::endTransformEdit(GameObjectManager& manager, GameObject* o
         return;
     }
 
-    if (obj->getObjectName() != m_editingObjName) {
+    if (obj->getHandle() != m_editingHandle) {
         m_isEditingTransform = false;
         return;
     }
@@ -251,7 +258,7 @@ void UndoRedoManager::endTransformEdit(GameObjectManager& manager, GameObject* o
         m_transformBefore.scaleZ != after.scaleZ);
 
     if (changed) {
-        auto cmd = std::make_unique<TransformCmd>(manager, m_editingObjName, m_transformBefore, after);
+        auto cmd = std::make_unique<TransformCmd>(manager, m_editingHandle, m_transformBefore, after);
 
         // add to undo deque
         m_undoDeque.push_back(std::move(cmd));
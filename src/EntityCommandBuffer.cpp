@@ -0,0 +1,73 @@
+/* Start Header ************************************************************************/
+/*!
+\file		EntityCommandBuffer.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Records structural changes during a frame and applies them at the sync
+            points in CoreEngine::Update.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "EntityCommandBuffer.h"
+#include "GameObjectManager.h"
+
+void EntityCommandBuffer::create(const std::string& name, ObjectFn init) {
+	m_commands.push_back({ CommandType::Create, EntityHandle{}, name, std::move(init) });
+}
+
+void EntityCommandBuffer::destroy(EntityHandle handle) {
+	if (handle.isNull()) return;
+	m_commands.push_back({ CommandType::Destroy, handle, {}, nullptr });
+}
+
+void EntityCommandBuffer::rename(EntityHandle handle, const std::string& newName) {
+	if (handle.isNull()) return;
+	m_commands.push_back({ CommandType::Rename, handle, newName, nullptr });
+}
+
+void EntityCommandBuffer::invoke(EntityHandle handle, ObjectFn fn) {
+	if (handle.isNull() || !fn) return;
+	m_commands.push_back({ CommandType::Invoke, handle, {}, std::move(fn) });
+}
+
+void EntityCommandBuffer::playback(GameObjectManager& manager) {
+	// a command can record more commands (e.g. a create whose init defers something),
+	// keep going until the buffer stays empty
+	while (!m_commands.empty()) {
+		m_playing.swap(m_commands);
+
+		for (Command& command : m_playing) {
+			if (command.type == CommandType::Create) {
+				GameObject* obj = manager.createGameObject(command.name);
+				if (command.fn) command.fn(*obj);
+				continue;
+			}
+
+			// the object may have been deleted since the command was recorded
+			GameObject* obj = manager.getGameObject(command.handle);
+			if (!obj) continue;
+
+			switch (command.type) {
+			case CommandType::Destroy:
+				manager.deleteGameObject(command.handle);
+				break;
+			case CommandType::Rename:
+				manager.renameGameObject(obj, command.name);
+				break;
+			case CommandType::Invoke:
+				command.fn(*obj);
+				break;
+			default:
+				break;
+			}
+		}
+
+		m_playing.clear();
+	}
+}
@@ -273,41 +273,20 @@ void GUISystem::removeButtons(GameObjectManager& manager) {
     m_buttons.clear(); //clear map
 }
 
-void GUISystem::startGame(GameObjectManager& manager) {
+void GUISystem::startGame(GameObjectManager& manager, const std::string& scene) {
     std::cout << "[GUI] Play button clicked - starting game" << std::endl;
     
     // Remove menu buttons
     removeButtons(manager);
 
     // Load the game scene
-    manager.init();
+    manager.init(scene);
     manager.initializeSceneResources();
 
     // Change game state
     m_currentState = GameState::PLAYING;
 
-    std::vector<GameObject*> gameObjects;
-    g_manager->getAllGameObjects(gameObjects);
-    //iterate over all Lua scripts in the folder
-    for (const auto& file : std::filesystem::directory_iterator("./assets/scripting")) {
-        if (file.path().extension() != ".lua") continue; //have to be .lua files if not it will skip
-        std::string filename = file.path().filename().string();
-
-        //strip ".lua" to get object name
-        std::string objectName = filename.substr(0, filename.size() - 4);
-
-        GameObject* obj = g_manager->getGameObject(objectName);
-        if (obj) {
-            obj->addComponent<LuaScript>(file.path().string()); //add LuaScript component to object
-            //load Lua script into Lua state
-            if (!g_luaSystem->loadScriptForObject(file.path().string(), objectName)) {
-                std::cerr << "[Lua] Failed to load script for " << objectName << std::endl;
-            }
-            else {
-                std::cout << "[Lua] Loaded script " << filename << " for object " << objectName << std::endl;
-            }
-        }
-    }
+    g_luaSystem->attachScripts(manager);
     std::cout << "[GUI] Game started - loaded json" << std::endl;
 }
 
@@ -16,7 +16,16 @@ Technology is prohibited.
 #include "GameObject.h"
 
 //constructor
-GameObject::GameObject(const std::string& name, const std::string& prefabID) : m_name(name), m_prefabID(prefabID) { autoMove = false;  }
+GameObject::GameObject(const std::string& name, const std::string& prefabID, ArchetypeStorage* storage)
+    : m_name(name), m_prefabID(prefabID), m_storage(storage ? storage : &ArchetypeStorage::detached()) {
+    autoMove = false;
+    m_storage->attach(*this);
+}
+
+GameObject::~GameObject() {
+    //destroys the components and frees up the row
+    m_storage->detach(*this);
+}
 
 const std::string& GameObject::getObjectName() const {
     return m_name;
@@ -36,24 +45,13 @@ std::string& GameObject::getObjectPrefabID() {
 
 std::unique_ptr<GameObject> GameObject::clone(const std::string& name) const {
 
-	std::unique_ptr<GameObject> newObject = std::make_unique<GameObject>(name);
+	//clone lives in the same storage (and archetype) as the original
+	std::unique_ptr<GameObject> newObject = std::make_unique<GameObject>(name, this->m_prefabID, m_storage);
 
-    newObject->m_prefabID = this->m_prefabID;
 	newObject->setLayer(this->m_layerID);
 
-    // Iterate through all components of the source object.
-	for (const auto& pair : m_components) { // Pair is [type_index, unique_ptr<Component>]
-        const std::unique_ptr<Component>& sourceComponent = pair.second;
-
-        if (sourceComponent) {
-            // Ask each component to clone itself.
-            std::unique_ptr<Component> newComponent = sourceComponent->clone();
-
-            // Add the newly created component copy to the new GameObject.
-            // We use the same type_index key from the original.
-            newObject->m_components[pair.first] = std::move(newComponent);
-        }
-    }
+    // Ask each component to clone itself into the new object's row.
+    m_storage->cloneComponents(*this, *newObject);
 
     return newObject;
 }
@@ -37,24 +37,41 @@ namespace {
 	}
 }
 
+GameObjectManager::~GameObjectManager() {
+	// objects live in the pool, so they have to be destroyed by hand
+	clearGameObjects();
+}
+
 // Create objects
 GameObject* GameObjectManager::createGameObject(const std::string& name) {
 
-	// Create a new GameObject and wrap it in a unique_ptr
-	auto newObject = std::make_unique<GameObject>(name);
+	// same as before handles, a new object with a taken name replaces the old one
+	deleteGameObject(getHandle(name));
+
+	// reuse a freed slot if there is one, the slot keeps its bumped generation
+	std::uint32_t index;
+	if (!m_freeSlots.empty()) {
+		index = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else {
+		index = static_cast<std::uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+	}
 
+	ObjectSlot& slot = m_slots[index];
+	slot.object = m_objectPool.create(name, "", &m_storage);
+	slot.denseIndex = static_cast<std::uint32_t>(m_gameObjects.size());
 
-	// Get raw pointer before transferring ownership
-	GameObject* ptr = newObject.get();
+	GameObject* ptr = slot.object;
+	ptr->m_handle = EntityHandle{ index, slot.generation };
 
+	m_gameObjects.push_back(ptr);
+	m_names[name] = ptr->m_handle;
 
 	//assign to default layer (game layer)
 	m_layerManager.assignObjectToLayer(ptr, 1);
 
-	// Store the unique_ptr in the map
-	m_gameObjects[name] = std::move(newObject);
-
-
 	return ptr;
 }
 
@@ -65,52 +82,108 @@ std::unique_ptr<GameObject> GameObjectManager::createTempGameObject(const std::s
 //use this when objects need to interact with each other
 GameObject* GameObjectManager::getGameObject(const std::string& name) {
 
-	//find object in map
-	auto iterator = m_gameObjects.find(name);
-	if (iterator != m_gameObjects.end()) {//if found
-		return iterator->second.get();
+	//find object in the name index
+	auto iterator = m_names.find(name);
+	if (iterator != m_names.end()) {//if found
+		return getGameObject(iterator->second);
 	}
 
 	return nullptr;
 }
 
+GameObject* GameObjectManager::getGameObject(EntityHandle handle) const {
+	if (handle.index >= m_slots.size()) return nullptr;
+
+	const ObjectSlot& slot = m_slots[handle.index];
+	if (slot.generation != handle.generation) return nullptr;
+
+	return slot.object;
+}
+
+bool GameObjectManager::isAlive(EntityHandle handle) const {
+	return getGameObject(handle) != nullptr;
+}
+
+EntityHandle GameObjectManager::getHandle(const std::string& name) const {
+	auto iterator = m_names.find(name);
+	return iterator != m_names.end() ? iterator->second : EntityHandle{};
+}
+
 void GameObjectManager::deleteGameObject(GameObject* object) {
 	if (!object) return;
 
+	deleteGameObject(object->getHandle());
+}
+
+void GameObjectManager::deleteGameObject(EntityHandle handle) {
+	GameObject* object = getGameObject(handle);
+	if (!object) return;
+
 	m_layerManager.removeObjectFromLayer(object);
+	m_prefabPool.forget(handle);
+	m_hierarchy.forget(handle);
 
-	for (auto iterator = m_gameObjects.begin(); iterator != m_gameObjects.end(); ++iterator) {
-		if (iterator->second.get() == object) {
-			m_gameObjects.erase(iterator);
-			return;
-		}
+	auto name = m_names.find(object->getObjectName());
+	if (name != m_names.end() && name->second == handle) m_names.erase(name);
+
+	// swap remove from the dense list
+	ObjectSlot& slot = m_slots[handle.index];
+	GameObject* last = m_gameObjects.back();
+	m_gameObjects[slot.denseIndex] = last;
+	m_slots[last->m_handle.index].denseIndex = slot.denseIndex;
+	m_gameObjects.pop_back();
+
+	// bump the generation first so anything looking the handle up during destruction misses
+	++slot.generation;
+	slot.object = nullptr;
+	m_freeSlots.push_back(handle.index);
+
+	m_objectPool.destroy(object);
+}
+
+void GameObjectManager::clearGameObjects() {
+	// anything still queued was meant for the old scene
+	m_commands.clear();
+	m_prefabPool.clear();
+	m_hierarchy.clear();
+	m_layerManager.clearAllLayers();
+	m_names.clear();
+
+	// no per object bookkeeping, every slot is freed and the pool is reset in bulk
+	for (GameObject* object : m_gameObjects) {
+		ObjectSlot& slot = m_slots[object->m_handle.index];
+		++slot.generation;
+		slot.object = nullptr;
+		m_freeSlots.push_back(object->m_handle.index);
+
+		object->~GameObject();
 	}
+	m_gameObjects.clear();
+	m_objectPool.reset();
 }
 
 //clone an existing object
 GameObject* GameObjectManager::CloneGameObject(const std::string& sourceName, const std::string& newName) {
 	//find object in map
-	auto iterator = m_gameObjects.find(sourceName);
+	GameObject* source = getGameObject(sourceName);
 
-	if (iterator == m_gameObjects.end()) {
+	if (!source) {
 		std::cout << "GameObject with name '" << sourceName << "' not found.\n";
 		return nullptr;
 	}
 
-	if (m_gameObjects.count(newName)) {
+	if (getGameObject(newName)) {
 		std::cout << "GameObject with name '" << newName << "' already exists.\n";
 		return nullptr;
 	}
 	
-	//cloning GameObject
-	std::unique_ptr<GameObject> clonedObject = iterator->second->clone(newName);
-
-	GameObject* ptr = clonedObject.get();//raw pointer
-
-	m_gameObjects[newName] = std::move(clonedObject);//move into map
+	//take a fresh slot, then clone the source's components into it
+	GameObject* ptr = createGameObject(newName);
+	ptr->getObjectPrefabID() = source->getObjectPrefabID();
+	m_storage.cloneComponents(*source, *ptr);
 	
 	//now to do for layer as well
-	assignObjectToLayer(ptr, iterator->second->getLayer());
+	assignObjectToLayer(ptr, source->getLayer());
 
 	return ptr;//return the raw pointer
 }
@@ -120,21 +193,21 @@ void GameObjectManager::getAllGameObjects(std::vector<GameObject*>& gameObjects)
 	//clear vector just in case
 	gameObjects.clear();
 
-	gameObjects.reserve(m_gameObjects.size());
+	gameObjects.assign(m_gameObjects.begin(), m_gameObjects.end());
+}
 
-	for (const auto& iterator : m_gameObjects) {
-		gameObjects.push_back(iterator.second.get());
-	}
+ArchetypeStorage& GameObjectManager::getStorage() {
+	return m_storage;
 }
 
 int GameObjectManager::getGameObjectCount() {
 	return static_cast<int>(m_gameObjects.size());
 }
 
-void GameObjectManager::init()
+void GameObjectManager::init(const std::string& scene)
 {
 
-	loadScene(JsonIO::runtimeScenePath("level01.json"));
+	loadScene(JsonIO::runtimeScenePath(scene));
 }
 
 bool GameObjectManager::renameGameObject(GameObject* obj, const std::string& newName) {
@@ -143,13 +216,13 @@ bool GameObjectManager::renameGameObject(GameObject* obj, const std::string& new
 
 	std::string oldName = obj->getObjectName();
 
-	if (m_gameObjects.find(newName) != m_gameObjects.end()) return false;
+	if (m_names.find(newName) != m_names.end()) return false;
 
-	auto node = m_gameObjects.extract(oldName);
-	if (node.empty()) return false;
+	auto node = m_names.extract(oldName);
+	if (node.empty() || node.mapped() != obj->getHandle()) return false;
 
 	node.key() = newName;
-	m_gameObjects.insert(std::move(node));
+	m_names.insert(std::move(node));
 
 	// rename if no duplicated name
 	obj->getObjectName() = newName;
@@ -262,16 +335,15 @@ void GameObjectManager::loadSceneFromJson(const std::string& filename) {
 
 	//std::cerr << "Cleared textures before loading scene.\n";
 	
-	m_layerManager.clearAllLayers();
-	m_gameObjects.clear();
+	clearGameObjects();
 
 	if (!doc.HasMember("objects") || !doc["objects"].IsArray()) {
 		std::cerr << "Scene JSON missing 'objects' array.\n";
 		return;
 	}
 
-	// prepare template for bullet
-	GameObject* templateBullet = nullptr;
+	// children are linked once every object exists, the parent may come later in the file
+	std::vector<std::pair<EntityHandle, std::string>> parentLinks;
 
 	for (auto& jObj : doc["objects"].GetArray()) {
 		if (!jObj.IsObject()) continue;
@@ -287,14 +359,6 @@ void GameObjectManager::loadSceneFromJson(const std::string& filename) {
 			std::string prefabID = jObj["prefabid"].GetString();
 			go->getObjectPrefabID() = prefabID;
 			PrefabManager::Instance().instantiate(go, *this);
-
-			/* ---- SCUFFED WAY TO GET BULLETS CLONE ---- */
-			// still hardcoded but slightly better than using name only
-			// if its bullet prefab, make this obj the template
-			if (prefabID == "b1a12273-a692-4ce0-8072-156da2c70842" && !templateBullet) {
-				templateBullet = go;
-			}
-			/* ---- END ---- */
 		}
 		//else {
 		//	// if no prefab, just create a fresh game object
@@ -305,7 +369,11 @@ void GameObjectManager::loadSceneFromJson(const std::string& filename) {
 
 		if (jObj.HasMember("layer") && jObj["layer"].IsInt()) {
 			int layerID = jObj["layer"].GetInt();
-			m_layerManager.assignObjectToLayer(go, layerID);
+			assignObjectToLayer(go, layerID);
+		}
+
+		if (jObj.HasMember("parent") && jObj["parent"].IsString()) {
+			parentLinks.emplace_back(go->getHandle(), jObj["parent"].GetString());
 		}
 
 		/*
@@ -337,6 +405,7 @@ void GameObjectManager::loadSceneFromJson(const std::string& filename) {
 				t->scaleY = jt["scale"][1].GetFloat();
 				t->scaleZ = jt["scale"][2].GetFloat();
 			}
+			t->markDirty();
 
 			/*std::cout << "\n\nReading from scene...\n";
 			std::cout << "Transform: x: " << t->x << ", y: " << t->y << ", z: " << t->z << std::endl;
@@ -387,6 +456,8 @@ void GameObjectManager::loadSceneFromJson(const std::string& filename) {
 				r->hasAnimation = false;
 			}
 
+			r->isStatic = JsonIO::GetBoolOr(jr, "static", false);
+
 			if (jr.HasMember("clr") && jr["clr"].IsArray() && jr["clr"].Size() == 3)
 			{
 				r->clr.r = jr["clr"][0].GetFloat();
@@ -684,7 +755,7 @@ void GameObjectManager::loadSceneFromJson(const std::string& filename) {
 			if (tmj.HasMember("rows") && tmj["rows"].IsInt())
 				tm->rows = tmj["rows"].GetInt();
 
-			tm->tiles.clear();
+			tm->clearTiles();
 
 			if (tmj.HasMember("tiles") && tmj["tiles"].IsArray()) {
 				for (const auto& t : tmj["tiles"].GetArray()) {
@@ -701,14 +772,25 @@ void GameObjectManager::loadSceneFromJson(const std::string& filename) {
 		
 	}
 
-	//create bullet pool
-	/* ---- SCUFFED WAY TO GET BULLET WORK ---- */
-	if (!templateBullet) templateBullet = getGameObject("bullet");
+	// world positions were saved, so linking just works the offsets out again
+	for (const auto& [child, parentName] : parentLinks) {
+		EntityHandle parent = getHandle(parentName);
+		if (parent.isNull() || !m_hierarchy.setParent(*this, child, parent)) {
+			std::cerr << "Scene load: could not attach an object to parent '" << parentName << "'.\n";
+		}
+	}
+
+	// prefab pools, e.g. "pools": [ { "prefabid": "...", "size": 10 } ]
+	if (doc.HasMember("pools") && doc["pools"].IsArray()) {
+		for (const auto& jPool : doc["pools"].GetArray()) {
+			if (!jPool.IsObject() || !jPool.HasMember("prefabid") || !jPool["prefabid"].IsString()) continue;
+
+			int size = (jPool.HasMember("size") && jPool["size"].IsInt()) ? jPool["size"].GetInt() : 0;
+			if (size <= 0) continue;
 
-	if (templateBullet) {
-		createBulletPool(templateBullet->getObjectName(), 10);
+			m_prefabPool.warmUp(*this, jPool["prefabid"].GetString(), static_cast<size_t>(size));
+		}
 	}
-	/* ---- END ---- */
 
 	std::cout << "Total game objects loaded: " << m_gameObjects.size() << std::endl;
 
@@ -740,29 +822,36 @@ void GameObjectManager::saveSceneToJson(const std::string& filename, bool isNew)
 
 	// version header
 	doc.AddMember("version", rapidjson::Value(1), a);
-	bool bulletSerialized = false;
 
 	if (!isNew) {
 
 		// objects array
 		rapidjson::Value objects(rapidjson::kArrayType);
 
-		for (auto const& kv : m_gameObjects) {
-			const GameObject* obj = kv.second.get();
+		// depth first, every parent is written right before its children
+		std::vector<const GameObject*> ordered;
+		ordered.reserve(m_gameObjects.size());
+		std::vector<EntityHandle> stack;
+		for (const GameObject* root : m_gameObjects) {
+			if (!m_hierarchy.getParent(root->getHandle()).isNull()) continue;
 
-			std::string objName = obj->getObjectName();
+			stack.push_back(root->getHandle());
+			while (!stack.empty()) {
+				EntityHandle current = stack.back();
+				stack.pop_back();
 
-			// if its a clone of bullet, serialize only the first one
-			if (obj->getObjectPrefabID() == "b1a12273-a692-4ce0-8072-156da2c70842") {
-				// if its a bullet, change name to bullet
-				if (!bulletSerialized) {
-					objName = "bullet";
-					bulletSerialized = true;
-				}
-				else {
-					continue;
-				}
+				if (const GameObject* object = getGameObject(current)) ordered.push_back(object);
+
+				const std::vector<EntityHandle>& children = m_hierarchy.getChildren(current);
+				for (auto child = children.rbegin(); child != children.rend(); ++child) stack.push_back(*child);
 			}
+		}
+
+		for (const GameObject* obj : ordered) {
+			// pooled objects are recreated from the "pools" entry below
+			if (m_prefabPool.isPooled(obj->getHandle())) continue;
+
+			std::string objName = obj->getObjectName();
 
 			rapidjson::Value jObj(rapidjson::kObjectType);
 
@@ -775,6 +864,11 @@ void GameObjectManager::saveSceneToJson(const std::string& filename, bool isNew)
 			// name
 			jObj.AddMember("name", rapidjson::Value(objName.c_str(), a), a);
 
+			// parent by name, the transform below is the world one
+			if (const GameObject* parent = getGameObject(m_hierarchy.getParent(obj->getHandle()))) {
+				jObj.AddMember("parent", rapidjson::Value(parent->getObjectName().c_str(), a), a);
+			}
+
 
 			// get prefab JSON if obj referencing a prefab
 			const rapidjson::Document* prefabDoc{ nullptr };
@@ -858,6 +952,8 @@ void GameObjectManager::saveSceneToJson(const std::string& filename, bool isNew)
 				}
 
 				pushIfDiffBool("hasAnimation", r->hasAnimation);
+				if (r->isStatic || (prefabR && prefabR->HasMember("static")))
+					pushIfDiffBool("static", r->isStatic);
 
 				if (!jr.ObjectEmpty()) comps.AddMember("Render", jr, a);
 			}
@@ -1152,6 +1248,15 @@ void GameObjectManager::saveSceneToJson(const std::string& filename, bool isNew)
 
 		// attach array
 		doc.AddMember("objects", objects, a);
+
+		rapidjson::Value pools(rapidjson::kArrayType);
+		for (const auto& [prefabID, size] : m_prefabPool.getPoolSizes()) {
+			rapidjson::Value jPool(rapidjson::kObjectType);
+			jPool.AddMember("prefabid", rapidjson::Value(prefabID.c_str(), a), a);
+			jPool.AddMember("size", rapidjson::Value(static_cast<int>(size)), a);
+			pools.PushBack(jPool, a);
+		}
+		if (!pools.Empty()) doc.AddMember("pools", pools, a);
 	}
 
 	std::string err;
@@ -1174,9 +1279,9 @@ void GameObjectManager::loadScene(const std::string& path) {
 
 	// PLEASE STOP CRASHING
 #ifdef _DEBUG
-	Editor::objSelectionState.selectedObject = nullptr;
+	Editor::objSelectionState.selectedObject = EntityHandle{};
 	Editor::objSelectionState.selectedPrefab = nullptr;
-	Editor::objSelectionState.draggedObject = nullptr;
+	Editor::objSelectionState.draggedObject = EntityHandle{};
 	Editor::objSelectionState.selectedIndex = -1;
 	UndoRedoManager::Instance().clear();
 
@@ -1186,6 +1291,8 @@ void GameObjectManager::loadScene(const std::string& path) {
 		Editor::sceneState.currentSceneName = filename;
 #endif
 
+	m_loadedScene = std::filesystem::path(path).filename().string();
+
 	if (ends_with(path, ".json")) loadSceneFromJson(path);
 	//if (GameObject* p = getGameObject("player")) {
 	//	if (!p->hasComponent<StateMachine>()) {
@@ -1238,8 +1345,7 @@ std::vector<GameObject*> GameObjectManager::getObjectsInLayer(int layerID) {
 
 void GameObjectManager::initializeSceneResources() {
 	// Load textures for render components
-	for (auto& pair : m_gameObjects) {
-		GameObject* obj = pair.second.get();
+	for (GameObject* obj : m_gameObjects) {
 		if (obj->hasComponent<Render>()) {
 			Render* render = obj->getComponent<Render>();
 			if (render->hasTex) {
@@ -1249,13 +1355,6 @@ void GameObjectManager::initializeSceneResources() {
 				render->texChanged = false;
 			}
 		}
-		// Initialize font models
-		if (obj->hasComponent<FontComponent>()) {
-			FontComponent* fc = obj->getComponent<FontComponent>();
-			if (!Font::fontMdls.empty()) {
-				fc->mdl = Font::fontMdls[0];
-			}
-		}
 		//initialize animation texture
 		if (obj->hasComponent<Animation>()) {
 			Animation* animation = obj->getComponent<Animation>();
@@ -1273,53 +1372,9 @@ void GameObjectManager::initializeSceneResources() {
 }
 
 
-void GameObjectManager::createBulletPool(const std::string& templateBulletName, int poolSize) {
-	GameObject* templateBullet = getGameObject(templateBulletName);
-	if (!templateBullet) {
-		std::cerr << "Error: Template bullet '" << templateBulletName << "' not found!\n";
-		return;
-	}
-
-	// ensure only 11 bullets (1+10 clone)
-	if (templateBullet->getObjectName() != "bullet") renameGameObject(templateBullet, "bullet");
-
-	std::cout << "Creating bullet pool with " << poolSize << " bullets...\n";
-
-	for (int i = 1; i <= poolSize; ++i) {
-		std::string bulletName = templateBulletName + std::to_string(i);
-
-		if (getGameObject(bulletName)) {
-			std::cout << "  Bullet already exists: " << bulletName << "\n";
-			continue;
-		}
-
-		/*GameObject* clonedBullet = */CloneGameObject(templateBulletName, bulletName);
-		//incase of bullets not cloned properly
-		//if (clonedBullet) {
-		//	if (clonedBullet->hasComponent<Transform>()) {
-		//		Transform* t = clonedBullet->getComponent<Transform>();
-		//		/*t->x = -1000.0f;
-		//		t->y = -1000.0f;*/
-		//	}
-		//	if (clonedBullet->hasComponent<Physics>()) {
-		//		Physics* p = clonedBullet->getComponent<Physics>();
-		//		/*p->alive = false;
-		//		p->dynamics.position.x = -1000.0f;
-		//		p->dynamics.position.y = -1000.0f;
-		//		p->dynamics.velocity.x = 0.0f;
-		//		p->dynamics.velocity.y = 0.0f;
-		//		p->dynamics.velocity.z = 0.0f;*/
-		//	}
-		//	std::cout << "  Created: " << bulletName << "\n";
-		//}
-	}
-	std::cout << "Bullet pool creation completed.\n";
-}
-
 void GameObjectManager::initializeSimulationResources() {
 	// Initialize audio for all objects
-	for (auto& pair : m_gameObjects) {
-		GameObject* obj = pair.second.get();
+	for (GameObject* obj : m_gameObjects) {
 		if (obj->hasComponent<AudioComponent>()) {
 			AudioComponent* audio = obj->getComponent<AudioComponent>();
 
@@ -1339,8 +1394,7 @@ void GameObjectManager::initializeSimulationResources() {
 
 void GameObjectManager::cleanupSimulationResources() {
 	// Stop all playing audio
-	for (auto& pair : m_gameObjects) {
-		GameObject* obj = pair.second.get();
+	for (GameObject* obj : m_gameObjects) {
 		if (obj->hasComponent<AudioComponent>()) {
 			AudioComponent* audio = obj->getComponent<AudioComponent>();
 			
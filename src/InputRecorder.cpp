@@ -0,0 +1,246 @@
+/* Start Header ************************************************************************/
+/*!
+\file		InputRecorder.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Session recording/replay and the per frame state hash, see InputRecorder.h.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "InputRecorder.h"
+#include "GameObjectManager.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+	const char MAGIC[4] = { 'R', 'P', 'L', 'Y' };
+
+	template <typename T>
+	void writeValue(std::ofstream& out, const T& value) {
+		out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	bool readValue(std::ifstream& in, T& value) {
+		return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	// FNV-1a, 64 bit
+	struct StateHasher {
+		std::uint64_t hash = 14695981039346656037ull;
+
+		void bytes(const void* data, size_t size) {
+			const unsigned char* byte = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= byte[i];
+				hash *= 1099511628211ull;
+			}
+		}
+
+		template <typename T>
+		void add(const T& value) { bytes(&value, sizeof(T)); }
+	};
+}
+
+bool InputRecorder::startRecording(const std::string& path, const std::string& scene, double fixedDt) {
+	stop();
+
+	m_out.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_out) {
+		std::cerr << "[Recorder] Cannot write " << path << "\n";
+		return false;
+	}
+
+	m_out.write(MAGIC, sizeof(MAGIC));
+	writeValue(m_out, VERSION);
+	writeValue(m_out, fixedDt);
+	writeValue(m_out, static_cast<std::uint16_t>(scene.size()));
+	m_out.write(scene.data(), static_cast<std::streamsize>(scene.size()));
+
+	m_path = path;
+	m_scene = scene;
+	m_fixedDt = fixedDt;
+	m_input = InputHandler::FrameInput{};
+	m_frame = 0;
+	m_mode = Mode::Recording;
+
+	std::cout << "[Recorder] Recording " << scene << " to " << path << "\n";
+	return true;
+}
+
+bool InputRecorder::startReplay(const std::string& path) {
+	stop();
+
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		std::cerr << "[Replay] Cannot open " << path << "\n";
+		return false;
+	}
+
+	char magic[4] = {};
+	std::uint32_t version = 0;
+	std::uint16_t sceneLength = 0;
+	in.read(magic, sizeof(magic));
+	if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !readValue(in, version) || version != VERSION
+		|| !readValue(in, m_fixedDt) || !readValue(in, sceneLength)) {
+		std::cerr << "[Replay] " << path << " is not a recording this build can read\n";
+		return false;
+	}
+
+	m_scene.assign(sceneLength, '\0');
+	in.read(&m_scene[0], sceneLength);
+
+	m_frames.clear();
+	Frame frame;
+	while (readFrame(in, frame)) m_frames.push_back(frame);
+
+	m_path = path;
+	m_input = InputHandler::FrameInput{};
+	m_frame = 0;
+	m_firstDivergence = -1;
+	m_mode = Mode::Replaying;
+
+	std::cout << "[Replay] " << m_frames.size() << " frames of " << m_scene << " from " << path << "\n";
+	return true;
+}
+
+void InputRecorder::stop() {
+	if (m_mode == Mode::Recording) {
+		m_out.close();
+		std::cout << "[Recorder] Saved " << m_frame << " frames to " << m_path << "\n";
+	}
+	else if (m_mode == Mode::Replaying) {
+		if (m_firstDivergence < 0) {
+			std::cout << "[Replay] " << m_frame << " frames replayed, state matched the recording on every frame\n";
+		}
+		else {
+			std::cout << "[Replay] " << m_frame << " frames replayed, first divergent frame: " << m_firstDivergence << "\n";
+		}
+		m_frames.clear();
+	}
+
+	m_mode = Mode::Off;
+}
+
+bool InputRecorder::beginFrame(float& dt, int& simSteps) {
+	if (m_mode == Mode::Recording) {
+		InputHandler::FrameInput current;
+		InputHandler::captureFrame(current);
+
+		m_pending.dt = dt;
+		m_pending.simSteps = static_cast<std::uint8_t>(simSteps);
+		m_pending.toggledKeys.clear();
+		for (std::uint16_t key = 0; key < 1024; ++key) {
+			if (current.keys[key] != m_input.keys[key]) m_pending.toggledKeys.push_back(key);
+		}
+		m_pending.mouseButtons = 0;
+		for (int button = 0; button < 8; ++button) {
+			if (current.mouseButtons[button]) m_pending.mouseButtons |= static_cast<std::uint8_t>(1u << button);
+		}
+		m_pending.mouseX = current.mousePosition.x;
+		m_pending.mouseY = current.mousePosition.y;
+		m_pending.scroll = current.scroll;
+
+		m_input = current;
+		return true;
+	}
+
+	if (m_mode == Mode::Replaying) {
+		if (m_frame >= m_frames.size()) {
+			stop();
+			return false;
+		}
+
+		const Frame& frame = m_frames[m_frame];
+		for (std::uint16_t key : frame.toggledKeys) {
+			if (key < 1024) m_input.keys[key] = !m_input.keys[key];
+		}
+		for (int button = 0; button < 8; ++button) {
+			m_input.mouseButtons[button] = ((frame.mouseButtons >> button) & 1u) != 0;
+		}
+		m_input.mousePosition.x = frame.mouseX;
+		m_input.mousePosition.y = frame.mouseY;
+		m_input.scroll = frame.scroll;
+
+		InputHandler::applyFrame(m_input);
+		dt = frame.dt;
+		simSteps = frame.simSteps;
+		return true;
+	}
+
+	return false;
+}
+
+void InputRecorder::endFrame(std::uint64_t stateHash) {
+	if (m_mode == Mode::Recording) {
+		m_pending.hash = stateHash;
+		writeFrame(m_pending);
+		++m_frame;
+	}
+	else if (m_mode == Mode::Replaying && m_frame < m_frames.size()) {
+		if (m_firstDivergence < 0 && m_frames[m_frame].hash != stateHash) {
+			m_firstDivergence = static_cast<long long>(m_frame);
+			std::cout << "[Replay] State diverged from the recording at frame " << m_frame << "\n";
+		}
+		++m_frame;
+	}
+}
+
+std::uint64_t InputRecorder::hashState(GameObjectManager& manager) {
+	StateHasher hasher;
+
+	manager.each<Transform>([&hasher](GameObject& object, Transform& transform) {
+		hasher.add(object.getHandle().toBits());
+		hasher.add(transform.x);
+		hasher.add(transform.y);
+		hasher.add(transform.rotation);
+		hasher.add(transform.flipX);
+	});
+
+	manager.each<Physics>([&hasher](GameObject& object, Physics& physics) {
+		hasher.add(object.getHandle().toBits());
+		hasher.add(physics.dynamics.position.x);
+		hasher.add(physics.dynamics.position.y);
+		hasher.add(physics.dynamics.velocity.x);
+		hasher.add(physics.dynamics.velocity.y);
+		hasher.add(physics.velX);
+		hasher.add(physics.velY);
+		hasher.add(physics.onGround);
+		hasher.add(physics.alive);
+		hasher.add(physics.lifeTimer);
+	});
+
+	return hasher.hash;
+}
+
+bool InputRecorder::readFrame(std::ifstream& in, Frame& frame) const {
+	std::uint16_t toggleCount = 0;
+	if (!readValue(in, frame.dt) || !readValue(in, frame.simSteps) || !readValue(in, toggleCount)) return false;
+
+	frame.toggledKeys.resize(toggleCount);
+	for (std::uint16_t& key : frame.toggledKeys) {
+		if (!readValue(in, key)) return false;
+	}
+
+	return readValue(in, frame.mouseButtons) && readValue(in, frame.mouseX) && readValue(in, frame.mouseY)
+		&& readValue(in, frame.scroll) && readValue(in, frame.hash);
+}
+
+void InputRecorder::writeFrame(const Frame& frame) {
+	writeValue(m_out, frame.dt);
+	writeValue(m_out, frame.simSteps);
+	writeValue(m_out, static_cast<std::uint16_t>(frame.toggledKeys.size()));
+	for (std::uint16_t key : frame.toggledKeys) writeValue(m_out, key);
+	writeValue(m_out, frame.mouseButtons);
+	writeValue(m_out, frame.mouseX);
+	writeValue(m_out, frame.mouseY);
+	writeValue(m_out, frame.scroll);
+	writeValue(m_out, frame.hash);
+}
@@ -0,0 +1,297 @@
+/* Start Header ************************************************************************/
+/*!
+\file		JobSystem.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Work stealing job system, parallelFor and TaskGraph.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace {
+	// which deque this thread owns, 0 for the main thread
+	thread_local unsigned t_threadSlot = 0;
+}
+
+/* ------------------------------ JobSystem ------------------------------ */
+
+JobSystem& JobSystem::getInstance() {
+	static JobSystem instance;
+	return instance;
+}
+
+JobSystem::~JobSystem() {
+	shutdown();
+}
+
+void JobSystem::init(int workerCount) {
+	shutdown();
+
+	unsigned count = 0;
+	if (workerCount < 0) {
+		unsigned cores = std::thread::hardware_concurrency();
+		count = cores > 1 ? cores - 1 : 0;
+	}
+	else {
+		count = static_cast<unsigned>(workerCount);
+	}
+
+	m_stopping = false;
+	m_queues.clear();
+	for (unsigned slot = 0; slot <= count; ++slot) {
+		m_queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	m_threads.reserve(count);
+	for (unsigned slot = 1; slot <= count; ++slot) {
+		m_threads.emplace_back(&JobSystem::workerLoop, this, slot);
+	}
+}
+
+void JobSystem::shutdown() {
+	if (m_threads.empty()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+
+	// workers drain every queue before they leave
+	for (std::thread& thread : m_threads) thread.join();
+	m_threads.clear();
+	m_queues.clear();
+}
+
+unsigned JobSystem::getThreadSlot() {
+	return t_threadSlot;
+}
+
+void JobSystem::submit(Job job, JobCounter* counter) {
+	if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+	QueuedJob queued{ std::move(job), counter };
+	if (m_threads.empty()) {
+		runJob(queued);
+		return;
+	}
+
+	WorkQueue& queue = *m_queues[getThreadSlot()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(std::move(queued));
+	}
+	m_queued.fetch_add(1);
+
+	{
+		// taking the lock orders this with a worker checking m_queued before it sleeps
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_wake.notify_one();
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+	while (counter.pending.load(std::memory_order_acquire) > 0) {
+		if (!tryRunOne()) std::this_thread::yield();
+	}
+}
+
+bool JobSystem::tryRunOne() {
+	if (m_threads.empty()) return false;
+
+	QueuedJob queued;
+	if (!popOrSteal(getThreadSlot(), queued)) return false;
+
+	runJob(queued);
+	return true;
+}
+
+size_t JobSystem::getSliceCount(size_t count, size_t minGrain) const {
+	if (count == 0) return 0;
+
+	size_t grain = std::max<size_t>(minGrain, 1);
+	size_t slices = (count + grain - 1) / grain;
+	return std::min<size_t>(slices, getThreadSlotCount() * SLICES_PER_THREAD);
+}
+
+void JobSystem::parallelFor(size_t count, size_t minGrain, const std::function<void(const JobRange&)>& fn) {
+	size_t slices = getSliceCount(count, minGrain);
+	if (slices == 0) return;
+
+	if (slices == 1) {
+		fn(JobRange{ 0, 0, count });
+		return;
+	}
+
+	// even split, the first count % slices slices get one extra item
+	const size_t base = count / slices;
+	const size_t extra = count % slices;
+
+	JobCounter counter;
+	size_t begin = 0;
+	for (size_t slice = 0; slice < slices; ++slice) {
+		size_t end = begin + base + (slice < extra ? 1 : 0);
+		submit([&fn, slice, begin, end] { fn(JobRange{ slice, begin, end }); }, &counter);
+		begin = end;
+	}
+
+	wait(counter);
+}
+
+void JobSystem::workerLoop(unsigned slot) {
+	t_threadSlot = slot;
+
+	for (;;) {
+		QueuedJob queued;
+		if (popOrSteal(slot, queued)) {
+			runJob(queued);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_wake.wait(lock, [this] { return m_stopping || m_queued.load() > 0; });
+		if (m_stopping && m_queued.load() == 0) return;
+	}
+}
+
+bool JobSystem::popOrSteal(unsigned slot, QueuedJob& out) {
+	// own jobs newest first, they are the most likely to still be in cache
+	{
+		WorkQueue& own = *m_queues[slot];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty()) {
+			out = std::move(own.jobs.back());
+			own.jobs.pop_back();
+			m_queued.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// steal the oldest job of the next thread that has one
+	const size_t queueCount = m_queues.size();
+	for (size_t offset = 1; offset < queueCount; ++offset) {
+		WorkQueue& victim = *m_queues[(slot + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			out = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			m_queued.fetch_sub(1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::runJob(QueuedJob& queued) {
+	queued.job();
+	if (queued.counter) queued.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+/* ------------------------------ TaskGraph ------------------------------ */
+
+size_t TaskGraph::addTask(const std::string& name, Task task, bool mainThread) {
+	m_nodes.push_back(Node{ name, std::move(task), mainThread, {}, {} });
+	return m_nodes.size() - 1;
+}
+
+void TaskGraph::addDependency(size_t before, size_t after) {
+	m_nodes[after].dependencies.push_back(before);
+	m_nodes[before].dependents.push_back(after);
+}
+
+void TaskGraph::run(JobSystem& jobs) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_jobs = &jobs;
+	m_error = nullptr;
+	m_remaining = m_nodes.size();
+	m_mainReady.clear();
+	m_waitingOn.resize(m_nodes.size());
+
+	for (size_t i = 0; i < m_nodes.size(); ++i) {
+		m_waitingOn[i] = m_nodes[i].dependencies.size();
+	}
+	for (size_t i = 0; i < m_nodes.size(); ++i) {
+		if (m_waitingOn[i] == 0) dispatch(i);
+	}
+
+	while (m_remaining > 0) {
+		if (!m_mainReady.empty()) {
+			// lowest index first so main thread tasks run in the order they were added
+			auto next = std::min_element(m_mainReady.begin(), m_mainReady.end());
+			size_t task = *next;
+			m_mainReady.erase(next);
+
+			lock.unlock();
+			execute(task);
+			lock.lock();
+
+			finish(task);
+			continue;
+		}
+
+		// nothing for the main thread yet, help the workers instead of idling
+		lock.unlock();
+		bool ranJob = jobs.tryRunOne();
+		lock.lock();
+
+		if (!ranJob && m_remaining > 0 && m_mainReady.empty()) m_mainWake.wait(lock);
+	}
+
+	if (m_error) {
+		std::exception_ptr error = m_error;
+		m_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+void TaskGraph::dispatch(size_t task) {
+	// with no workers everything runs on the main thread
+	if (m_nodes[task].mainThread || m_jobs->getWorkerCount() == 0) {
+		m_mainReady.push_back(task);
+		m_mainWake.notify_one();
+		return;
+	}
+
+	m_jobs->submit([this, task] {
+		execute(task);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		finish(task);
+	});
+}
+
+void TaskGraph::finish(size_t task) {
+	for (size_t dependent : m_nodes[task].dependents) {
+		if (--m_waitingOn[dependent] == 0) dispatch(dependent);
+	}
+
+	--m_remaining;
+	m_mainWake.notify_one();
+}
+
+void TaskGraph::execute(size_t task) {
+	{
+		// once something has failed the rest of the run is skipped
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_error) return;
+	}
+
+	try {
+		m_nodes[task].task();
+	}
+	catch (...) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_error) m_error = std::current_exception();
+	}
+}
@@ -555,6 +555,7 @@ namespace JsonIO {
 
             // 0/1 to mirror prior text formats
             jr.AddMember("hasAnimation", Value(r->hasAnimation ? 1 : 0), a);
+            if (r->isStatic) jr.AddMember("static", Value().SetBool(true), a);
             JsonIO::WriteVec3(jr, "clr", r->clr.x, r->clr.y, r->clr.z, a);
 
             doc.AddMember("Render", jr, a);
@@ -757,6 +758,8 @@ namespace JsonIO {
                     r->hasAnimation = false;
                 }
 
+                r->isStatic = GetBoolOr(jr, "static", false);
+
                 ReadVec3(jr, "clr", r->clr.x, r->clr.y, r->clr.z);
             }
 
@@ -867,7 +870,7 @@ namespace JsonIO {
                 if (tmj.HasMember("columns"))  tm->columns = tmj["columns"].GetInt();
                 if (tmj.HasMember("rows"))     tm->rows = tmj["rows"].GetInt();
 
-                tm->tiles.clear();
+                tm->clearTiles();
 
                 if (tmj.HasMember("tiles") && tmj["tiles"].IsArray()) {
                     for (const auto& t : tmj["tiles"].GetArray()) {
@@ -933,8 +936,7 @@ void GameObjectManager::saveToJson(const std::string& filename, bool isNew) cons
     if (!isNew) {
         rapidjson::Value objects(rapidjson::kArrayType);
 
-        for (auto const& kv : m_gameObjects) {
-            const GameObject* obj = kv.second.get();
+        for (const GameObject* obj : m_gameObjects) {
 
             rapidjson::Value jObj(rapidjson::kObjectType);
 
@@ -977,6 +979,7 @@ void GameObjectManager::saveToJson(const std::string& filename, bool isNew) cons
 
                 // 0/1 to mirror prior text formats
                 jr.AddMember("hasAnimation", rapidjson::Value(r->hasAnimation ? 1 : 0), a);
+                if (r->isStatic) jr.AddMember("static", rapidjson::Value().SetBool(true), a);
 
                 // Optional future flags:
                 // jr.AddMember("visible",     rapidjson::Value().SetBool(r->visible), a);
@@ -1062,7 +1065,7 @@ void GameObjectManager::loadFromJson(const std::string& filename) {
         std::cerr << "Warning: unsupported scene version " << version << "\n";
 
     // Start fresh
-    m_gameObjects.clear();
+    clearGameObjects();
 
     // Validate presence of objects array
     if (!doc.HasMember("objects") || !doc["objects"].IsArray()) {
@@ -1136,6 +1139,8 @@ void GameObjectManager::loadFromJson(const std::string& filename) {
                 r->hasAnimation = false;
             }
 
+            r->isStatic = JsonIO::GetBoolOr(jr, "static", false);
+
             // Optional future flags:
             // if (jr.HasMember("visible")     && jr["visible"].IsBool())     r->visible       = jr["visible"].GetBool();
             // if (jr.HasMember("transparent") && jr["transparent"].IsBool()) r->isTransparent = jr["transparent"].GetBool();
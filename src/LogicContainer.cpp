@@ -56,6 +56,71 @@ static inline bool anyMoveHeld() {
 // ============================================================================
 // FSM Transition Helper
 // ============================================================================
+/*!
+ * \brief Plays the sounds that go with leaving prev and entering next.
+ *
+ * \param audio The AudioComponent of the object changing state.
+ * \param prev  The PlayerState being left.
+ * \param next  The PlayerState being entered.
+ */
+void LogicContainer::playTransitionAudio(AudioComponent& audio, PlayerState prev, PlayerState next)
+{
+    //if prev state was walking
+    if (prev == PlayerState::Walking) {
+
+        //stop footsteps when leaving walking state
+
+        AudioChannel* footsteps = audio.getChannel("footsteps");
+        if (footsteps && footsteps->state == AudioState::Playing) {
+            footsteps->isPendingStop = true;
+            footsteps->fadeOutOnStop = true;
+            footsteps->fadeOutDuration = 0.15f;
+        }
+    }
+
+    //if prev state was falling, means exiting falling state(just landed prolly)
+    if (prev == PlayerState::Falling) {
+        AudioChannel* landing = audio.getOrCreateChannel("landing");
+        
+        //play sound when exiting falling state
+        landing->audioFile = "assets/audio/landing.wav";
+        landing->loop = false;
+        landing->volume = 1.0f;
+        landing->isPendingPlay = true;
+    }
+
+    //play a sound depending on next state
+    switch (next) {
+    case PlayerState::Walking : {//jump jump
+        AudioChannel* footsteps = audio.getOrCreateChannel("footsteps");
+        footsteps->audioFile = "assets/audio/footsteps.wav";
+        footsteps->loop = true;
+        footsteps->volume = 0.5f;
+        footsteps->isPendingPlay = true;
+        break;
+    }
+    case PlayerState::Jumping: {
+        AudioChannel* jump = audio.getOrCreateChannel("jump");
+        jump->audioFile = "assets/audio/jump.wav";
+        jump->loop = false;
+        jump->volume = 0.7f;
+        jump->isPendingPlay = true;
+        break;
+    }
+    case PlayerState::Falling: {
+        //play falling sound
+        break;
+    }
+    case PlayerState::Idle: {
+        //play some idle sound if needed
+        break;
+    }
+    default:
+        //prolly nothing happens
+        break;   
+    }
+}
+
 /*!
  * \brief Applies a state transition to the object�s StateMachine component.
  *
@@ -64,8 +129,9 @@ static inline bool anyMoveHeld() {
  *
  * \param obj Reference to the GameObject owning the FSM.
  * \param next The next PlayerState to enter.
+ * \param commands Where the AudioComponent is queued if the object has none yet.
  */
-void LogicContainer::enter(GameObject& obj, PlayerState next)
+void LogicContainer::enter(GameObject& obj, PlayerState next, EntityCommandBuffer& commands)
 {
     if (auto* fsm = obj.getComponent<StateMachine>())
     {
@@ -90,76 +156,22 @@ void LogicContainer::enter(GameObject& obj, PlayerState next)
             std::cout << msg << std::endl;
 
 
-            //get or add AudioComponent
+            //audio for the transition, the component is added on the first transition
             AudioComponent* audio = obj.getComponent<AudioComponent>();
-            if (!audio) {
-                audio = obj.addComponent<AudioComponent>();
+            if (audio) {
+                playTransitionAudio(*audio, fsm->state, next);
             }
-
-            if (!audio) {
-                std::cerr << "[LogicContainer] Failed to get/create AudioComponent for "
-                    << obj.getObjectName() << std::endl;
-                fsm->state = next;
-                fsm->stateTime = 0.0f;
-                return;  // Early return if audio component is invalid
-            }
-
-            //if prev state was walking
-            if (fsm->state == PlayerState::Walking) {
-
-                //stop footsteps when leaving walking state
-
-                AudioChannel* footsteps = audio->getChannel("footsteps");
-                if (footsteps && footsteps->state == AudioState::Playing) {
-                    footsteps->isPendingStop = true;
-                    footsteps->fadeOutOnStop = true;
-                    footsteps->fadeOutDuration = 0.15f;
-                }
-            }
-
-            //if prev state was falling, means exiting falling state(just landed prolly)
-            if (fsm->state == PlayerState::Falling) {
-                AudioChannel* landing = audio->getOrCreateChannel("landing");
-                
-                //play sound when exiting falling state
-                landing->audioFile = "assets/audio/landing.wav";
-                landing->loop = false;
-                landing->volume = 1.0f;
-                landing->isPendingPlay = true;
+            else {
+                // adding a component moves the object inside the storage while the logic
+                // system is still iterating, so it is added at playback. a second transition
+                // before then queues another of these, which finds the component the first added
+                PlayerState prev = fsm->state;
+                commands.invoke(obj.getHandle(), [prev, next](GameObject& owner) {
+                    AudioComponent* audio = owner.getComponent<AudioComponent>();
+                    if (!audio) audio = owner.addComponent<AudioComponent>();
+                    if (audio) playTransitionAudio(*audio, prev, next);
+                });
             }
-
-            //play a sound depending on next state
-            switch (next) {
-            case PlayerState::Walking : {//jump jump
-                AudioChannel* footsteps = audio->getOrCreateChannel("footsteps");
-                footsteps->audioFile = "assets/audio/footsteps.wav";
-                footsteps->loop = true;
-                footsteps->volume = 0.5f;
-                footsteps->isPendingPlay = true;
-                break;
-            }
-            case PlayerState::Jumping: {
-                AudioChannel* jump = audio->getOrCreateChannel("jump");
-                jump->audioFile = "assets/audio/jump.wav";
-                jump->loop = false;
-                jump->volume = 0.7f;
-                jump->isPendingPlay = true;
-                break;
-            }
-            case PlayerState::Falling: {
-                //play falling sound
-                break;
-            }
-            case PlayerState::Idle: {
-                //play some idle sound if needed
-                break;
-            }
-            default:
-                //prolly nothing happens
-                break;   
-            }
-
-
         }
 
         fsm->state = next;
@@ -179,21 +191,22 @@ void LogicContainer::enter(GameObject& obj, PlayerState next)
  *
  * \param obj Player GameObject.
  * \param dt Delta time (unused).
+ * \param commands Deferred structural changes, passed on to enter().
  */
-void LogicContainer::tickIdle(GameObject& obj, float /*dt*/) {
+void LogicContainer::tickIdle(GameObject& obj, float /*dt*/, EntityCommandBuffer& commands) {
     auto* physics = obj.getComponent<Physics>();
     if (!physics) return;
 
     // jump
-    if (InputHandler::isKeyTriggered(GLFW_KEY_B) && physics->onGround) {
+    if (InputHandler::isKeyTriggeredThisStep(GLFW_KEY_B) && physics->onGround) {
         physics->velY = physics->jumpForce;
         physics->onGround = false;
-        enter(obj, PlayerState::Jumping);
+        enter(obj, PlayerState::Jumping, commands);
         DebugLog::addMessage("FSM: Jump", DebugMode::PlaySimul);
     }
     // walk
     else if (anyMoveHeld() && obj.getObjectPrefabID() != "eaa2ba42-971a-413b-b8c4-99b2f5ab674d" && obj.getObjectPrefabID() != "f04819ff-270c-41b4-8387-73382eb85103") {
-        enter(obj, PlayerState::Walking);
+        enter(obj, PlayerState::Walking, commands);
     }
 }
 
@@ -211,8 +224,9 @@ void LogicContainer::tickIdle(GameObject& obj, float /*dt*/) {
  *
  * \param obj The player GameObject.
  * \param dt Delta time (unused).
+ * \param commands Deferred structural changes, passed on to enter().
  */
-void LogicContainer::tickWalking(GameObject& obj, float /*dt*/) {
+void LogicContainer::tickWalking(GameObject& obj, float /*dt*/, EntityCommandBuffer& commands) {
     auto* physics = obj.getComponent<Physics>();
     auto* fsm = obj.getComponent<StateMachine>();
     if (!physics || !fsm) return;
@@ -237,17 +251,17 @@ void LogicContainer::tickWalking(GameObject& obj, float /*dt*/) {
     }
         
     if (!anyMoveHeld() && !(fsm->fixState)) {
-        enter(obj, PlayerState::Idle);
+        enter(obj, PlayerState::Idle, commands);
         return;
     }
     if (!physics->onGround && physics->velY < 0.0f) {
-        enter(obj, PlayerState::Falling);
+        enter(obj, PlayerState::Falling, commands);
         return;
     }
-    if (InputHandler::isKeyTriggered(GLFW_KEY_B) && physics->onGround) {
+    if (InputHandler::isKeyTriggeredThisStep(GLFW_KEY_B) && physics->onGround) {
         physics->velY = physics->jumpForce;
         physics->onGround = false;
-        enter(obj, PlayerState::Jumping);
+        enter(obj, PlayerState::Jumping, commands);
         DebugLog::addMessage("FSM: Jump", DebugMode::PlaySimul);
         return;
     }
@@ -263,13 +277,14 @@ void LogicContainer::tickWalking(GameObject& obj, float /*dt*/) {
  *
  * \param obj The player GameObject.
  * \param dt Delta time (unused).
+ * \param commands Deferred structural changes, passed on to enter().
  */
-void LogicContainer::tickJumping(GameObject& obj, float /*dt*/) {
+void LogicContainer::tickJumping(GameObject& obj, float /*dt*/, EntityCommandBuffer& commands) {
     auto* physics = obj.getComponent<Physics>();
     if (!physics) return;
 
     if (physics->velY <= 0.0f) {
-        enter(obj, PlayerState::Falling);
+        enter(obj, PlayerState::Falling, commands);
     }
 }
 
@@ -285,14 +300,15 @@ void LogicContainer::tickJumping(GameObject& obj, float /*dt*/) {
  *
  * \param obj The player GameObject.
  * \param dt Delta time (unused).
+ * \param commands Deferred structural changes, passed on to enter().
  */
-void LogicContainer::tickFalling(GameObject& obj, float /*dt*/) {
+void LogicContainer::tickFalling(GameObject& obj, float /*dt*/, EntityCommandBuffer& commands) {
     auto* physics = obj.getComponent<Physics>();
     if (!physics) return;
 
     if (physics->onGround) {
-        if (anyMoveHeld()) enter(obj, PlayerState::Walking);
-        else               enter(obj, PlayerState::Idle);
+        if (anyMoveHeld()) enter(obj, PlayerState::Walking, commands);
+        else               enter(obj, PlayerState::Idle, commands);
     }
 }
 
@@ -375,9 +391,9 @@ void LogicContainer::tickDead(GameObject& obj, float /*dt*/) {
  * - Run per-state tick function (Idle/Walking/Jumping/Falling)
  * \param obj The player GameObject being updated.
  * \param dt Delta time in seconds.
- * \param manager GameObjectManager used for spawning bullets.
+ * \param commands Deferred structural changes (e.g. adding audio), played back after the logic system.
  */
-void LogicContainer::update(GameObject& obj, float dt /*, GameObjectManager& manager*/) {
+void LogicContainer::update(GameObject& obj, float dt, EntityCommandBuffer& commands) {
     auto* fsm = obj.getComponent<StateMachine>();
     if (!fsm) return;
 
@@ -389,10 +405,10 @@ void LogicContainer::update(GameObject& obj, float dt /*, GameObjectManager& man
     }*/
 
     switch (fsm->state) {
-    case PlayerState::Idle:     tickIdle(obj, dt);     break;
-    case PlayerState::Walking:  tickWalking(obj, dt);  break;
-    case PlayerState::Jumping:  tickJumping(obj, dt);  break;
-    case PlayerState::Falling:  tickFalling(obj, dt);  break;
+    case PlayerState::Idle:     tickIdle(obj, dt, commands);     break;
+    case PlayerState::Walking:  tickWalking(obj, dt, commands);  break;
+    case PlayerState::Jumping:  tickJumping(obj, dt, commands);  break;
+    case PlayerState::Falling:  tickFalling(obj, dt, commands);  break;
     case PlayerState::Dead:     tickDead(obj, dt);     break;
     default: break;
     }
@@ -0,0 +1,160 @@
+/* Start Header ************************************************************************/
+/*!
+\file		ObjectPool.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Prefab keyed object pools, see ObjectPool.h.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "ObjectPool.h"
+#include "GameObjectManager.h"
+#include "prefabManager.h"
+
+#include <algorithm>
+#include <iostream>
+
+bool ObjectPool::warmUp(GameObjectManager& manager, const std::string& prefabID, size_t count) {
+	PrefabManager& prefabs = PrefabManager::Instance();
+	if (!prefabs.hasPrefab(prefabID)) {
+		std::cerr << "[ObjectPool] Unknown prefab '" << prefabID << "', pool not created.\n";
+		return false;
+	}
+
+	Pool& pool = m_pools[prefabID];
+	if (pool.prefabName.empty()) pool.prefabName = prefabs.getPrefabName(prefabID);
+
+	while (pool.size < count) {
+		// skip numbers whose name is already taken by something in the scene
+		std::string name;
+		do {
+			name = pool.prefabName + std::to_string(++pool.nextNumber);
+		} while (manager.getGameObject(name));
+
+		GameObject* object = manager.createGameObject(name);
+		object->getObjectPrefabID() = prefabID;
+		if (!prefabs.instantiate(object, manager)) {
+			manager.deleteGameObject(object);
+			std::cerr << "[ObjectPool] Failed to instantiate prefab '" << pool.prefabName << "'.\n";
+			return false;
+		}
+
+		CollisionInfo* collision = object->getComponent<CollisionInfo>();
+		m_members[object->getHandle()] = Member{ &pool, NOT_ACTIVE, collision && collision->collisionFlag };
+		park(*object);
+		pool.free.push_back(object->getHandle());
+		++pool.size;
+	}
+
+	return true;
+}
+
+GameObject* ObjectPool::acquire(GameObjectManager& manager, const std::string& prefabID) {
+	auto it = m_pools.find(prefabID);
+	if (it == m_pools.end()) return nullptr;
+
+	Pool& pool = it->second;
+	while (!pool.free.empty()) {
+		EntityHandle handle = pool.free.back();
+		pool.free.pop_back();
+
+		GameObject* object = manager.getGameObject(handle);
+		if (!object) continue; // deleted behind our back, forget() already dropped it
+
+		Member& member = m_members[handle];
+		member.activeIndex = m_active.size();
+		m_active.push_back(handle);
+
+		if (Render* render = object->getComponent<Render>()) render->visible = true;
+		if (CollisionInfo* collision = object->getComponent<CollisionInfo>()) collision->collisionFlag = member.collides;
+		return object;
+	}
+
+	return nullptr;
+}
+
+bool ObjectPool::release(GameObjectManager& manager, EntityHandle handle) {
+	auto it = m_members.find(handle);
+	if (it == m_members.end() || it->second.activeIndex == NOT_ACTIVE) return false;
+
+	// swap remove from the active list
+	Member& member = it->second;
+	EntityHandle last = m_active.back();
+	m_active[member.activeIndex] = last;
+	m_members[last].activeIndex = member.activeIndex;
+	m_active.pop_back();
+
+	member.activeIndex = NOT_ACTIVE;
+	member.pool->free.push_back(handle);
+
+	if (GameObject* object = manager.getGameObject(handle)) park(*object);
+	return true;
+}
+
+const std::string& ObjectPool::findPrefabID(const std::string& prefabName) const {
+	static const std::string none;
+
+	// only a handful of pools, a linear search is fine
+	for (const auto& [prefabID, pool] : m_pools) {
+		if (pool.prefabName == prefabName) return prefabID;
+	}
+	return none;
+}
+
+size_t ObjectPool::getSize(const std::string& prefabID) const {
+	auto it = m_pools.find(prefabID);
+	return it != m_pools.end() ? it->second.size : 0;
+}
+
+size_t ObjectPool::getFreeCount(const std::string& prefabID) const {
+	auto it = m_pools.find(prefabID);
+	return it != m_pools.end() ? it->second.free.size() : 0;
+}
+
+std::vector<std::pair<std::string, size_t>> ObjectPool::getPoolSizes() const {
+	std::vector<std::pair<std::string, size_t>> sizes;
+	sizes.reserve(m_pools.size());
+	for (const auto& [prefabID, pool] : m_pools) {
+		sizes.emplace_back(prefabID, pool.size);
+	}
+	return sizes;
+}
+
+void ObjectPool::forget(EntityHandle handle) {
+	auto it = m_members.find(handle);
+	if (it == m_members.end()) return;
+
+	Member& member = it->second;
+	if (member.activeIndex != NOT_ACTIVE) {
+		EntityHandle last = m_active.back();
+		m_active[member.activeIndex] = last;
+		m_members[last].activeIndex = member.activeIndex;
+		m_active.pop_back();
+	}
+	else {
+		// rare (editor delete), the stale handle is skipped by acquire but drop it now anyway
+		std::vector<EntityHandle>& free = member.pool->free;
+		free.erase(std::remove(free.begin(), free.end(), handle), free.end());
+	}
+
+	--member.pool->size;
+	m_members.erase(it);
+}
+
+void ObjectPool::clear() {
+	m_pools.clear();
+	m_members.clear();
+	m_active.clear();
+}
+
+void ObjectPool::park(GameObject& object) {
+	if (Render* render = object.getComponent<Render>()) render->visible = false;
+	if (Physics* physics = object.getComponent<Physics>()) physics->alive = false;
+	if (CollisionInfo* collision = object.getComponent<CollisionInfo>()) collision->collisionFlag = false;
+}
@@ -18,6 +18,8 @@ Technology is prohibited.
 /* End Header **************************************************************************/
 #include "ResourceManager.h"
 
+#include <algorithm>
+
 class AudioHandler; // Forward declaration
 
 ResourceManager& ResourceManager::getInstance() {
@@ -43,6 +45,11 @@ void ResourceManager::shutdown() {
         glDeleteTextures(1, &pair.second.id);
     }
     m_textureCache.clear();
+    for (TextureArray& textureArray : m_textureArrays) {
+        glDeleteTextures(1, &textureArray.id);
+    }
+    m_textureArrays.clear();
+    m_textureLayers.clear();
     std::cout << "ResourceManager: Cleared all textures." << std::endl;
 
     //Release all sounds
@@ -57,21 +64,19 @@ void ResourceManager::shutdown() {
         glDeleteProgram(pair.second);
     }
     m_shaderCache.clear();
+    m_uniformLocations.clear();
     std::cout << "ResourceManager: Cleared all shaders." << std::endl;
 
-    //Release all fonts and their character textures
+    //Release all fonts and their glyph atlases
     for (auto& pair : m_fontCache) {
-        //Delete all character textures for this font
-        for (auto& charPair : pair.second.characters) {
-            if (charPair.second.TextureID) {
-                glDeleteTextures(1, &charPair.second.TextureID);
-            }
+        if (pair.second.atlas) {
+            glDeleteTextures(1, &pair.second.atlas);
         }
         // Free the FreeType face
         FT_Done_Face(pair.second.face);
     }
     m_fontCache.clear();
-    std::cout << "ResourceManager: Cleared all fonts and character textures." << std::endl;
+    std::cout << "ResourceManager: Cleared all fonts and glyph atlases." << std::endl;
 
     if(m_ftLibrary) {
         FT_Done_FreeType(m_ftLibrary);
@@ -82,6 +87,11 @@ void ResourceManager::shutdown() {
 	std::cout << "ResourceManager: Shutdown complete." << std::endl;
 }
 
+const TextureData* ResourceManager::findTexture(const std::string& path) const {
+    auto it = m_textureCache.find(path);
+    return it != m_textureCache.end() ? &it->second : nullptr;
+}
+
 TextureData ResourceManager::getTexture(const std::string& path) {
     if (path.empty()) {
         return { 0, false };
@@ -125,10 +135,13 @@ TextureData ResourceManager::loadTextureFromFile(const std::string& filename) {
 	TextureData textureData;
     textureData.isTransparent = (channels == 4);
 
+    TextureLayer layer = allocateTextureLayer(width, height);
+    glTextureSubImage3D(layer.array, 0, 0, 0, static_cast<GLint>(layer.layer), width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+    //a 2D view of the layer, shares the array's memory
     GLuint texobj_hdl;
-    glCreateTextures(GL_TEXTURE_2D, 1, &texobj_hdl);
-    glTextureStorage2D(texobj_hdl, 1, GL_RGBA8, static_cast<GLuint>(width), static_cast<GLuint>(height));
-    glTextureSubImage2D(texobj_hdl, 0, 0, 0, static_cast<GLuint>(width), static_cast<GLuint>(height), GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glGenTextures(1, &texobj_hdl);
+    glTextureView(texobj_hdl, GL_TEXTURE_2D, layer.array, GL_RGBA8, 0, 1, layer.layer, 1);
 
     glTextureParameteri(texobj_hdl, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTextureParameteri(texobj_hdl, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -138,10 +151,65 @@ TextureData ResourceManager::loadTextureFromFile(const std::string& filename) {
     stbi_image_free(data);
     
     textureData.id = texobj_hdl;
+    textureData.array = layer.array;
+    textureData.layer = layer.layer;
+
+    setTextureLayer(texobj_hdl, layer);
     
     return textureData;
 }
 
+void ResourceManager::setTextureLayer(GLuint texture, TextureLayer layer) {
+    if (m_textureLayers.size() <= texture) m_textureLayers.resize(texture + 1);
+    m_textureLayers[texture] = layer;
+}
+
+TextureLayer ResourceManager::allocateTextureLayer(int width, int height) {
+    for (TextureArray& textureArray : m_textureArrays) {
+        if (textureArray.width == width && textureArray.height == height && textureArray.used < textureArray.layers) {
+            return { textureArray.id, static_cast<GLuint>(textureArray.used++) };
+        }
+    }
+
+    scanTextureSizes();
+
+    //room for every image of this size, or just this one if it is not under assets/
+    TextureArray textureArray;
+    textureArray.width = width;
+    textureArray.height = height;
+    auto count = m_textureSizeCounts.find({ width, height });
+    textureArray.layers = count != m_textureSizeCounts.end() ? count->second : 1;
+
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &textureArray.id);
+    glTextureStorage3D(textureArray.id, 1, GL_RGBA8, width, height, textureArray.layers);
+    glTextureParameteri(textureArray.id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(textureArray.id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(textureArray.id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(textureArray.id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    std::cout << "ResourceManager: New " << width << "x" << height << " texture array with "
+        << textureArray.layers << " layer(s)" << std::endl;
+
+    textureArray.used = 1;
+    m_textureArrays.push_back(textureArray);
+    return { textureArray.id, 0 };
+}
+
+void ResourceManager::scanTextureSizes() {
+    if (m_textureSizesScanned) return;
+    m_textureSizesScanned = true;
+
+    std::error_code error;
+    for (std::filesystem::recursive_directory_iterator it("assets", error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file(error)) continue;
+
+        int width, height, channels;
+        if (stbi_info(it->path().string().c_str(), &width, &height, &channels)) {
+            ++m_textureSizeCounts[{ width, height }];
+        }
+    }
+}
+
 FMOD::Sound* ResourceManager::getSound(const std::string& path, bool loop) {
     if (path.empty() || !m_fmodSystem) {
         return nullptr;
@@ -224,6 +292,7 @@ GLuint ResourceManager::getShader(const std::string& vertPath, const std::string
     GLuint program = LoadShaders(fullVert, fullFrag, /*p_loadFromFile=*/true);
     if (program != 0) {
         m_shaderCache[key] = program;
+        cacheUniformLocations(program);
     }
     else {
         std::cout << "ResourceManager Error: Failed to load shader program: "
@@ -232,6 +301,42 @@ GLuint ResourceManager::getShader(const std::string& vertPath, const std::string
     return program;
 }
 
+GLint ResourceManager::getUniformLocation(GLuint program, const std::string& name) const {
+    auto programIt = m_uniformLocations.find(program);
+    if (programIt == m_uniformLocations.end()) return -1;
+
+    auto it = programIt->second.find(name);
+    return it != programIt->second.end() ? it->second : -1;
+}
+
+void ResourceManager::cacheUniformLocations(GLuint program) {
+    std::unordered_map<std::string, GLint>& locations = m_uniformLocations[program];
+    locations.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(static_cast<size_t>(std::max(maxLength, 1)), '\0');
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+        std::string uniform = name.substr(0, static_cast<size_t>(length));
+
+        // members of uniform blocks have no location, the block is bound instead
+        GLint location = glGetUniformLocation(program, uniform.c_str());
+        if (location == -1) continue;
+
+        // arrays are listed as "name[0]", the location is the first element's
+        if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0) {
+            uniform.erase(uniform.size() - 3);
+        }
+        locations[uniform] = location;
+    }
+}
 
 const FontData& ResourceManager::getFont(const std::string& relativePath) {
     if(relativePath.empty()) {
@@ -275,7 +380,14 @@ FontData ResourceManager::loadFontFromFile(const std::string& path) {
 
     FT_Set_Pixel_Sizes(fontData.face, 0, 48); //set default size
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    // glyphs go left to right in rows (shelves) as tall as the tallest glyph in them, with a
+    // pixel between glyphs so filtering does not pick up the neighbour. the height is only
+    // known at the end, so the pixels are gathered here and uploaded once
+    const int atlasWidth = 1024;
+    const int padding = 1;
+    std::vector<unsigned char> pixels;
+    std::vector<std::pair<unsigned char, glm::ivec2>> placed; // glyph, top left in the atlas
+    int penX = padding, penY = padding, shelfHeight = 0;
 
     for (unsigned char c = 0; c < 255; c++) {
         // load character glyph 
@@ -285,39 +397,66 @@ FontData ResourceManager::loadFontFromFile(const std::string& path) {
             continue;
         }
 
-        // generate texture
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            fontData.face->glyph->bitmap.width,
-            fontData.face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            fontData.face->glyph->bitmap.buffer
-        );
-        // set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        // now store character for later use
+        const FT_Bitmap& bitmap = fontData.face->glyph->bitmap;
+        const int width = static_cast<int>(bitmap.width);
+        const int rows = static_cast<int>(bitmap.rows);
+
+        // now store character for later use, the uvs are filled in once the atlas size is known
         FontCharacter character = {
-            texture,
-            glm::ivec2(fontData.face->glyph->bitmap.width, fontData.face->glyph->bitmap.rows),
+            glm::vec4(0.f),
+            glm::ivec2(width, rows),
             glm::ivec2(fontData.face->glyph->bitmap_left, fontData.face->glyph->bitmap_top),
             static_cast<GLuint>(fontData.face->glyph->advance.x)
         };
-
         fontData.characters[c] = character;
+
+        // spaces and the like take no room
+        if (width == 0 || rows == 0) continue;
+
+        if (penX + width + padding > atlasWidth) {
+            penX = padding;
+            penY += shelfHeight + padding;
+            shelfHeight = 0;
+        }
+        if (pixels.size() < static_cast<size_t>(penY + rows + padding) * atlasWidth) {
+            pixels.resize(static_cast<size_t>(penY + rows + padding) * atlasWidth, 0);
+        }
+
+        // rows are pitch bytes apart in the bitmap, top row first
+        for (int row = 0; row < rows; ++row) {
+            const unsigned char* src = bitmap.buffer + row * bitmap.pitch;
+            std::copy(src, src + width, pixels.begin() + static_cast<size_t>(penY + row) * atlasWidth + penX);
+        }
+        placed.emplace_back(c, glm::ivec2(penX, penY));
+
+        penX += width + padding;
+        shelfHeight = std::max(shelfHeight, rows);
+    }
+
+    const int atlasHeight = std::max(1, static_cast<int>(pixels.size() / atlasWidth));
+    pixels.resize(static_cast<size_t>(atlasHeight) * atlasWidth, 0);
+
+    glCreateTextures(GL_TEXTURE_2D, 1, &fontData.atlas);
+    glTextureStorage2D(fontData.atlas, 1, GL_R8, atlasWidth, atlasHeight);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    glTextureSubImage2D(fontData.atlas, 0, 0, 0, atlasWidth, atlasHeight, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+    glTextureParameteri(fontData.atlas, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(fontData.atlas, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(fontData.atlas, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(fontData.atlas, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    for (const auto& [c, corner] : placed) {
+        FontCharacter& character = fontData.characters[c];
+        character.uvRect = glm::vec4(
+            static_cast<float>(corner.x) / atlasWidth,
+            static_cast<float>(corner.y) / atlasHeight,
+            static_cast<float>(corner.x + character.Size.x) / atlasWidth,
+            static_cast<float>(corner.y + character.Size.y) / atlasHeight);
     }
 
 	fontData.isLoaded = true;
-    std::cout << "Loaded font: " << path << " (" << fontData.characters.size() << " characters)" << std::endl;
+    std::cout << "Loaded font: " << path << " (" << fontData.characters.size() << " characters, "
+        << atlasWidth << "x" << atlasHeight << " atlas)" << std::endl;
 
     return fontData;
 }
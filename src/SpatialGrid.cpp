@@ -0,0 +1,156 @@
+/* Start Header ************************************************************************/
+/*!
+\file		SpatialGrid.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 16th, 2026
+\brief      Uniform grid of object bounds, see SpatialGrid.h.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::insert(EntityHandle handle, const Rect& bounds, std::uint32_t stamp) {
+	if (handle.isNull()) return;
+	if (handle.index >= m_entries.size()) m_entries.resize(handle.index + 1);
+
+	int minX = cellOf(bounds.minX);
+	int minY = cellOf(bounds.minY);
+	int maxX = cellOf(bounds.maxX);
+	int maxY = cellOf(bounds.maxY);
+	long long cells = static_cast<long long>(maxX - minX + 1) * (maxY - minY + 1);
+	bool oversized = cells > MAX_CELLS_PER_OBJECT;
+
+	Entry& entry = m_entries[handle.index];
+
+	// most moves stay inside the same cells, only the bounds change then
+	if (entry.inGrid && entry.handle == handle && entry.oversized == oversized
+		&& (oversized || (entry.cellMinX == minX && entry.cellMinY == minY && entry.cellMaxX == maxX && entry.cellMaxY == maxY))) {
+		entry.bounds = bounds;
+		entry.stamp = stamp;
+		return;
+	}
+
+	if (entry.inGrid) unlink(handle.index);
+
+	entry.handle = handle;
+	entry.bounds = bounds;
+	entry.cellMinX = minX;
+	entry.cellMinY = minY;
+	entry.cellMaxX = maxX;
+	entry.cellMaxY = maxY;
+	entry.stamp = stamp;
+	entry.oversized = oversized;
+	entry.inGrid = true;
+	++m_count;
+
+	if (oversized) {
+		m_oversized.push_back(handle.index);
+		return;
+	}
+
+	for (int y = minY; y <= maxY; ++y) {
+		for (int x = minX; x <= maxX; ++x) {
+			m_cells[CellKey{ x, y }].push_back(handle.index);
+		}
+	}
+}
+
+void SpatialGrid::remove(EntityHandle handle) {
+	if (handle.index >= m_entries.size()) return;
+
+	Entry& entry = m_entries[handle.index];
+	if (!entry.inGrid || entry.handle != handle) return;
+
+	unlink(handle.index);
+}
+
+void SpatialGrid::query(const Rect& area, std::vector<EntityHandle>& out) {
+	// a new mark per query instead of clearing every entry's
+	if (++m_queryMark == 0) {
+		for (Entry& entry : m_entries) entry.queryMark = 0;
+		m_queryMark = 1;
+	}
+
+	auto visit = [this, &area, &out](std::uint32_t index) {
+		Entry& entry = m_entries[index];
+		if (entry.queryMark == m_queryMark) return;
+		entry.queryMark = m_queryMark;
+		if (entry.bounds.overlaps(area)) out.push_back(entry.handle);
+	};
+
+	int minX = cellOf(area.minX);
+	int minY = cellOf(area.minY);
+	int maxX = cellOf(area.maxX);
+	int maxY = cellOf(area.maxY);
+	long long cells = static_cast<long long>(maxX - minX + 1) * (maxY - minY + 1);
+
+	if (cells > static_cast<long long>(m_cells.size())) {
+		// zoomed out past the level, cheaper to go over the cells that exist
+		for (auto& [key, indices] : m_cells) {
+			if (key.x < minX || key.x > maxX || key.y < minY || key.y > maxY) continue;
+			for (std::uint32_t index : indices) visit(index);
+		}
+	}
+	else {
+		for (int y = minY; y <= maxY; ++y) {
+			for (int x = minX; x <= maxX; ++x) {
+				auto it = m_cells.find(CellKey{ x, y });
+				if (it == m_cells.end()) continue;
+				for (std::uint32_t index : it->second) visit(index);
+			}
+		}
+	}
+
+	for (std::uint32_t index : m_oversized) visit(index);
+}
+
+void SpatialGrid::clear() {
+	m_entries.clear();
+	m_cells.clear();
+	m_oversized.clear();
+	m_queryMark = 0;
+	m_count = 0;
+}
+
+int SpatialGrid::cellOf(float value) const {
+	// clamped so a stray huge transform can not overflow the int
+	float cell = std::floor(value / m_cellSize);
+	return static_cast<int>(std::clamp(cell, -1.0e8f, 1.0e8f));
+}
+
+void SpatialGrid::unlink(std::uint32_t index) {
+	Entry& entry = m_entries[index];
+
+	auto eraseFrom = [index](std::vector<std::uint32_t>& indices) {
+		auto it = std::find(indices.begin(), indices.end(), index);
+		if (it == indices.end()) return;
+		*it = indices.back();
+		indices.pop_back();
+	};
+
+	if (entry.oversized) {
+		eraseFrom(m_oversized);
+	}
+	else {
+		for (int y = entry.cellMinY; y <= entry.cellMaxY; ++y) {
+			for (int x = entry.cellMinX; x <= entry.cellMaxX; ++x) {
+				auto it = m_cells.find(CellKey{ x, y });
+				if (it == m_cells.end()) continue;
+				// empty cells stay, objects moving back and forth would make them over and over
+				eraseFrom(it->second);
+			}
+		}
+	}
+
+	entry.inGrid = false;
+	--m_count;
+}
@@ -0,0 +1,46 @@
+/* Start Header ************************************************************************/
+/*!
+\file		SystemScheduler.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Builds the system dependency graph from the declared reads/writes and runs
+            it every frame on the main thread plus the job system.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "SystemScheduler.h"
+
+void SystemScheduler::addSystem(const std::string& name, const SystemAccess& access, SystemThread thread, SystemFn fn) {
+	size_t index = m_graph.addTask(name, [this, fn = std::move(fn)] { fn(m_deltaTime); }, thread == SystemThread::Main);
+
+	// main thread systems keep their order, GL submission depends on it.
+	// only the closest one is needed, it already waits on the ones before it
+	size_t previousMain = index;
+	if (thread == SystemThread::Main) {
+		for (size_t other = index; other-- > 0;) {
+			if (m_systems[other].thread == SystemThread::Main) {
+				previousMain = other;
+				break;
+			}
+		}
+	}
+
+	for (size_t other = 0; other < index; ++other) {
+		if (other == previousMain || access.conflictsWith(m_systems[other].access)) {
+			m_graph.addDependency(other, index);
+		}
+	}
+
+	m_systems.push_back(SystemEntry{ access, thread });
+}
+
+void SystemScheduler::run(float deltaTime) {
+	m_deltaTime = deltaTime;
+	m_graph.run(JobSystem::getInstance());
+}
@@ -26,14 +26,19 @@ Technology is prohibited.
 #include "Systems.h"
 #include "Physics.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
 std::string TileMapSystem::filename{};
+RenderSystem::CullStats RenderSystem::cullStats{};
+RenderSystem::QueueStats RenderSystem::queueStats{};
 //here we go buddies
 
-//all the systems need to get all game objects
-//then it needs to check through the list of 
-//game objects to check if the valid component
-//is present or not
-//so all systems need to use the getAllGameObjects() function
+//systems ask the manager for a view<Components...>() of only the objects
+//that have the components they care about, instead of getting every
+//game object and checking each one
 //JumpForce jumpForce;
 //BulletForce bulletForce;
 // Input system - reads user input and updates velocity accordingly
@@ -42,9 +47,7 @@ void InputSystem::update(GameObjectManager& manager, const float& deltaTime, Mes
 	(void)messageBus;
 	//record current time for performance tracking
 	auto start = std::chrono::high_resolution_clock::now();
-
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
+	(void)manager;
 
 	//for (GameObject* iterator : gameObjects) {
 	//	//check for objects that have input 
@@ -92,7 +95,7 @@ void InputSystem::update(GameObjectManager& manager, const float& deltaTime, Mes
 
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count(); //get elapse time in ms
-	g_SystemTimers.push_back({ "Input", ms }); //saving timing for UI output
+	PushSystemTimer("Input", ms); //saving timing for UI output
 }
 
 // Render system - draws all game objects with a Render component
@@ -100,14 +103,13 @@ void RenderSystem::update(GameObjectManager& manager, float const& deltaTime)
 {
 	//record current time for performance tracking
 	auto start = std::chrono::high_resolution_clock::now();
-	batchingSetUp(manager, deltaTime);
 
 	//we aint doing this anymore 
 	//std::vector<GameObject*> gameObjects;
 	//manager.getAllGameObjects(gameObjects);
 
 	LayerManager& layerManager = manager.getLayerManager();
-	std::vector<Layer*> layers = layerManager.getAllLayers();
+	layerManager.getAllLayers(layers);
 
 	glm::mat4 camView, camProj;
 
@@ -131,6 +133,9 @@ void RenderSystem::update(GameObjectManager& manager, float const& deltaTime)
 		camProj = renderer::cam.proj;
 	}
 
+	//only what the camera can see gets batched
+	batchingSetUp(manager, deltaTime, viewRect(activeCamera()));
+
 	//std::vector<GameObject*> objectWithTex;
 	//std::vector<GameObject*> objectWithoutTex;
 
@@ -206,52 +211,19 @@ void RenderSystem::update(GameObjectManager& manager, float const& deltaTime)
 
 
 	}
-	//drawing models without texture
-	glUseProgram(renderer::shdr_pgm[1]);
-	GLint uView = glGetUniformLocation(renderer::shdr_pgm[1], "V");
-	GLint uProj = glGetUniformLocation(renderer::shdr_pgm[1], "P");
-	glUniformMatrix4fv(uView, 1, GL_FALSE, glm::value_ptr(camView));
-	glUniformMatrix4fv(uProj, 1, GL_FALSE, glm::value_ptr(camProj));
-	for (std::pair<const shape, std::vector<renderer::InstanceData>>& pair : objectWithoutTex)
-	{
-		shape meshType = pair.first;
-		renderer::drawInstances(renderer::models[(int)meshType], pair.second);
-	}
-	//drawing models with texture
-	glUseProgram(renderer::shdr_pgm[0]); // hasTex shader
-	uView = glGetUniformLocation(renderer::shdr_pgm[0], "V");
-	uProj = glGetUniformLocation(renderer::shdr_pgm[0], "P");
-	glUniformMatrix4fv(uView, 1, GL_FALSE, glm::value_ptr(camView));
-	glUniformMatrix4fv(uProj, 1, GL_FALSE, glm::value_ptr(camProj));
-	for (std::pair<const BatchKey, std::vector<renderer::InstanceData>>& pair : objectWithTex)
-	{
-		const BatchKey& key = pair.first;
-		//std::vector<renderer::InstanceData>& instances = pair.second;
-		glBindTextureUnit(0, key.texID);
-		GLint uTexLoc = glGetUniformLocation(renderer::shdr_pgm[0], "uTex2d");
-		if (uTexLoc != -1) 
-			glUniform1i(uTexLoc, 0);
-		renderer::model& mdl = renderer::models[(int)key.meshType];
-		renderer::drawInstances(mdl, pair.second);
-	}
-	for (std::pair<const BatchKey, std::vector<renderer::InstanceData>>& pair : objectWithTex2)
-	{
-		const BatchKey& key = pair.first;
-		//std::vector<renderer::InstanceData>& instances = pair.second;
-		glBindTextureUnit(0, key.texID);
-		GLint uTexLoc = glGetUniformLocation(renderer::shdr_pgm[0], "uTex2d");
-		if (uTexLoc != -1)
-			glUniform1i(uTexLoc, 0);
-		renderer::model& mdl = renderer::models[(int)key.meshType];
-		renderer::drawInstances(mdl, pair.second);
-	}
+	//every run of the sorted queue is queued into this frame's part of the instance ring and
+	//draw list, and goes out in one multi draw per program switch
+	renderer::updateFrameData(camView, camProj, deltaTime, glm::vec2(fboWidth, fboHeight));
+	renderer::beginInstanceFrame();
+	drawQueue();
+	renderer::endInstanceFrame();
 
 	/*if (UISystem::isShowUI()) glBindFramebuffer(GL_FRAMEBUFFER, 0);*/
 
 	//record end time for performance tracking
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count(); //get elapse time in ms
-	g_SystemTimers.push_back({"Render", ms }); //saving timing for UI output
+	PushSystemTimer("Render", ms); //saving timing for UI output
 }
 
 void RenderSystem::renderFBO() {
@@ -305,6 +277,7 @@ void RenderSystem::createFBO() {
 }
 
 RenderSystem::~RenderSystem() {
+	for (StaticGroup& group : staticGroups) renderer::destroy_static_batch(group.batch);
 	if (texture) glDeleteTextures(1, &texture);
 	if (fbo) glDeleteFramebuffers(1, &fbo);
 	if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
@@ -316,68 +289,274 @@ void RenderSystem::init(GameObjectManager& manager, int fboW, int fboH)
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	//stbi_set_flip_vertically_on_load(true);
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-	for (GameObject* object : gameObjects)
+	manager.each<Render>([](GameObject&, Render& renderRef)
 	{
-		if (object->hasComponent<Render>()) {
-			Render* render = object->getComponent<Render>();
-			if (object->getComponent<Render>()->hasTex)
-			{
-				//render->texHDL = uploadtex(render->texFile, render->isTransparent);
-				TextureData textureData = ResourceManager::getInstance().getTexture(render->texFile);
-				render->texHDL = textureData.id;
-				render->isTransparent = textureData.isTransparent;
-				//std::cerr << "Texture ID for " << render->texFile << ": " << render->texHDL << std::endl;
-				//std::cerr << "Is Transparent: " << (render->isTransparent ? "Yes" : "No") << std::endl;
+		Render* render = &renderRef;
+		if (render->hasTex)
+		{
+			//render->texHDL = uploadtex(render->texFile, render->isTransparent);
+			TextureData textureData = ResourceManager::getInstance().getTexture(render->texFile);
+			render->texHDL = textureData.id;
+			render->isTransparent = textureData.isTransparent;
+			//std::cerr << "Texture ID for " << render->texFile << ": " << render->texHDL << std::endl;
+			//std::cerr << "Is Transparent: " << (render->isTransparent ? "Yes" : "No") << std::endl;
+		}
+	});
+
+	manager.each<Animation>([](GameObject&, Animation& animation)
+	{
+		for (AnimateState& as : animation.animState) {
+			if (!as.texFile.empty()) {
+				TextureData textureData = ResourceManager::getInstance().getTexture(as.texFile);
+				as.texHDL = textureData.id;
+			}
+		}
+	});
+	fboWidth = fboW;
+	fboHeight = fboH;
+}
+
+renderer::camera& RenderSystem::activeCamera()
+{
+	return (UISystem::isShowUI() && EditorManager::isEditingMode()) ? renderer::editorCam : renderer::cam;
+}
+
+SpatialGrid::Rect RenderSystem::viewRect(const renderer::camera& cam)
+{
+	// glm::ortho(-zoom * ar, zoom * ar, -zoom, zoom) around the camera position
+	float halfW = cam.zoom * cam.ar;
+	float halfH = cam.zoom;
+	return { cam.campos.x - halfW, cam.campos.y - halfH, cam.campos.x + halfW, cam.campos.y + halfH };
+}
+
+namespace {
+	// everywhere the object can be drawn until the next fixed step: anything between its
+	// previous and current position (interpolation), grown by the furthest its shape
+	// reaches at any rotation
+	SpatialGrid::Rect objectBounds(const Transform& transform, const Render& render)
+	{
+		float sx = std::abs(transform.scaleX);
+		float sy = std::abs(transform.scaleY);
+		float extent = render.modelRef.shape == shape::square ? 0.5f * std::sqrt(sx * sx + sy * sy) : std::max(sx, sy);
+
+		float fromX = transform.hasPrev ? transform.prevX : transform.x;
+		float fromY = transform.hasPrev ? transform.prevY : transform.y;
+		return { std::min(fromX, transform.x) - extent, std::min(fromY, transform.y) - extent,
+			std::max(fromX, transform.x) + extent, std::max(fromY, transform.y) + extent };
+	}
+
+	// Render::isStatic only counts for what a static batch can show: a loaded texture, no animation
+	bool drawnStatic(GameObject& object, const Render& render)
+	{
+		return render.isStatic && render.hasTex && render.texHDL
+			&& !(render.hasAnimation && object.hasComponents<Animation, StateMachine>());
+	}
+
+	// FNV-1a of everything that ends up in a static object's instance
+	std::uint64_t hashStatic(const GameObject& object, const Transform& transform, const Render& render)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		auto add = [&hash](const auto& value) {
+			const unsigned char* byte = reinterpret_cast<const unsigned char*>(&value);
+			for (size_t i = 0; i < sizeof(value); ++i) {
+				hash ^= byte[i];
+				hash *= 1099511628211ull;
 			}
+		};
+		add(object.getHandle().toBits());
+		add(object.getLayer());
+		add(transform.x);
+		add(transform.y);
+		add(transform.z);
+		add(transform.rotation);
+		add(transform.scaleX);
+		add(transform.scaleY);
+		add(transform.flipX);
+		add(render.visible);
+		add(render.texHDL);
+		add(render.clr);
+		add(render.modelRef.shape);
+		return hash;
+	}
+
+	// render queue key, most significant bits first:
+	//   layer 8 | transparent 1 | opaque:      shader 1 | texture 16 | mesh 2 | depth 24, front to back
+	//                             transparent: depth 24, back to front | shader 1 | texture 16 | mesh 2
+	// layers always draw in order, but they share one depth buffer: z still decides between
+	// the opaque pixels of different layers, the layer only orders the draws. opaque draws
+	// group by state and leave the order to the depth buffer, front to back so hidden
+	// pixels fail early. transparent ones blend, so they have to go back to front and the
+	// state only groups draws at the same depth
+	constexpr int KEY_LAYER_SHIFT = 56;
+	constexpr int KEY_TRANSPARENT_SHIFT = 55;
+
+	std::uint64_t makeSortKey(int layer, bool transparent, bool textured, GLuint texture, shape mesh, float z)
+	{
+		// layer ids outside 0..255 share the ends
+		std::uint64_t layerBits = static_cast<std::uint64_t>(std::clamp(layer, 0, 255));
+		// z inside the camera's -1..1 range, larger z is nearer
+		std::uint64_t depth = static_cast<std::uint64_t>(std::clamp((z + 1.f) * 0.5f, 0.f, 1.f) * 16777215.f);
+		std::uint64_t state = (static_cast<std::uint64_t>(textured ? 1 : 0) << 18)
+			| (static_cast<std::uint64_t>(texture & 0xFFFF) << 2)
+			| static_cast<std::uint64_t>(static_cast<int>(mesh) & 0x3);
+
+		std::uint64_t key = (layerBits << KEY_LAYER_SHIFT) | (static_cast<std::uint64_t>(transparent ? 1 : 0) << KEY_TRANSPARENT_SHIFT);
+		if (transparent)
+			key |= (depth << 31) | (state << 12);
+		else
+			key |= (state << 36) | ((16777215ull - depth) << 12);
+		return key;
+	}
+}
+
+void RenderSystem::stepAnimations(GameObjectManager& manager, float deltaTime)
+{
+	if (EditorManager::isEditingMode() || EditorManager::isPaused()) return;
+
+	manager.each<Render, Animation, StateMachine>([deltaTime](GameObject&, Render& render, Animation& animation, StateMachine& sm)
+	{
+		// hidden, e.g. a free object sitting in its pool
+		if (!render.visible || !render.hasAnimation) return;
+
+		AnimateState& as = animation.animState[static_cast<int>(sm.state)];
+		if (as.texFile.empty() || !as.loop) return;
+
+		as.frameTimer += deltaTime;
+		if (as.frameTimer < as.frameTime) return;
+
+		as.frameTimer -= as.frameTime;
+		if (as.currentFrameColumn >= as.lastFrame.x && as.currentFrameRow >= as.lastFrame.y)
+		{
+			as.currentFrameColumn = (int)as.initialFrame.x;
+			as.currentFrameRow = (int)as.initialFrame.y;
+			as.frameTimer = 0;
 		}
+		else
+		{
+			++as.currentFrameColumn;
 
-		if (object->hasComponent<Animation>()) {
-			Animation* animation = object->getComponent<Animation>();
-			if (!animation->animState.empty())
+			if (as.currentFrameColumn >= as.totalColumn)
 			{
-				for (AnimateState& as : animation->animState) {
-					if (!as.texFile.empty()) {
-						TextureData textureData = ResourceManager::getInstance().getTexture(as.texFile);
-						as.texHDL = textureData.id;
-					}
+				as.currentFrameColumn = 0;
+				++as.currentFrameRow;
+
+				if (as.currentFrameRow > as.lastFrame.y)
+				{
+					as.currentFrameColumn = (int)as.initialFrame.x;
+					as.currentFrameRow = (int)as.initialFrame.y;
 				}
 			}
 		}
-	}
-	fboWidth = fboW;
-	fboHeight = fboH;
+		animation.runItBack = true;
+	});
 }
 
-void RenderSystem::batchingSetUp(GameObjectManager& manager, float const& deltaTime)
+void RenderSystem::batchingSetUp(GameObjectManager& manager, float const& deltaTime, const SpatialGrid::Rect& viewRect)
 {
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-	for (std::pair < const BatchKey, std::vector<renderer::InstanceData>>& pair : objectWithTex) pair.second.clear();
-	for (std::pair < const shape, std::vector<renderer::InstanceData>>& pair : objectWithoutTex) pair.second.clear();
+	queueItems.clear();
+	queueStatics.clear();
+	sortEntries.clear();
+
+	// bring the grid up to date. Transform::version moves on with every write, so anything
+	// whose version matches what it was indexed with is where the grid thinks it is
+	View<Transform, Render> view = manager.view<Transform, Render>();
+	view.collectChunks(batchChunks);
 
-	for (GameObject* obj : gameObjects)
+	JobSystem& jobs = JobSystem::getInstance();
+	const size_t chunksPerSlice = 4;
+	size_t slices = jobs.getSliceCount(batchChunks.size(), chunksPerSlice);
+	if (batchScratch.size() < slices) batchScratch.resize(slices);
+
+	jobs.parallelFor(batchChunks.size(), chunksPerSlice, [&](const JobRange& range)
 	{
-		if (!obj->hasComponent<Render>() || !obj->hasComponent<Transform>())
-			continue;
-		Render* render = obj->getComponent<Render>();
-		Transform* transform = obj->getComponent<Transform>();
+		BatchScratch& scratch = batchScratch[range.slice];
+		for (size_t i = range.begin; i < range.end; ++i) {
+			view.eachIn(batchChunks[i], [&](GameObject& object, Transform& transform, Render& render) {
+				// not in the grid, drawn from staticGroups
+				if (drawnStatic(object, render)) {
+					scratch.statics.push_back(object.getHandle());
+					scratch.staticHash += hashStatic(object, transform, render);
+					return;
+				}
+				if (render.visible) ++scratch.shown;
+				if (!objectGrid.isCurrent(object.getHandle(), transform.version)) {
+					scratch.moved.push_back(GridUpdate{ object.getHandle(), objectBounds(transform, render), transform.version });
+				}
+			});
+		}
+	});
+
+	size_t shown = 0;
+	size_t reindexed = 0;
+	std::uint64_t staticHash = 0;
+	staticObjects.clear();
+	for (size_t slice = 0; slice < slices; ++slice) {
+		BatchScratch& scratch = batchScratch[slice];
+		for (const GridUpdate& update : scratch.moved) {
+			objectGrid.insert(update.handle, update.bounds, update.version);
+		}
+		reindexed += scratch.moved.size();
+		shown += scratch.shown;
+		scratch.moved.clear();
+		scratch.shown = 0;
+
+		staticObjects.insert(staticObjects.end(), scratch.statics.begin(), scratch.statics.end());
+		staticHash += scratch.staticHash;
+		scratch.statics.clear();
+		scratch.staticHash = 0;
+	}
+
+	// the per object hashes are summed, so any static object edited, added or removed
+	// changes the sum (or the count) and the batch is built again. otherwise it stays as is
+	if (staticHash != staticObjectHash || staticObjects.size() != staticObjectCount) {
+		staticObjectHash = staticHash;
+		staticObjectCount = staticObjects.size();
+		buildStaticObjects(manager);
+	}
+
+	// index order keeps the instance order steady from frame to frame, the grid's is not
+	visibleObjects.clear();
+	objectGrid.query(viewRect, visibleObjects);
+	std::sort(visibleObjects.begin(), visibleObjects.end(),
+		[](const EntityHandle& a, const EntityHandle& b) { return a.index < b.index; });
+
+	const size_t objectsPerSlice = 64;
+	slices = jobs.getSliceCount(visibleObjects.size(), objectsPerSlice);
+	if (batchScratch.size() < slices) batchScratch.resize(slices);
+
+	const float alpha = interpolationAlpha;
+	auto batchObject = [alpha](BatchScratch& scratch, GameObject& object, Transform& transformRef, Render& renderRef)
+	{
+		GameObject* obj = &object;
+		Render* render = &renderRef;
+		Transform* transform = &transformRef;
+
+		// hidden, e.g. a free object sitting in its pool
+		if (!render->visible) return;
 
 		float scaleX = transform->flipX ? -transform->scaleX : transform->scaleX;
 
-		renderer::InstanceData data;
-		float angle = glm::radians(transform->rotation);
-		transform->mdlWorld = glm::mat4{ 1 };
-		transform->mdlWorld = glm::translate(transform->mdlWorld, glm::vec3(transform->x, transform->y, transform->z));
-		transform->mdlWorld = glm::rotate(transform->mdlWorld, angle, glm::vec3(0, 0, 1.f));
-		transform->mdlWorld = glm::scale(transform->mdlWorld, glm::vec3(scaleX, transform->scaleY, transform->scaleZ));
-		data.model = transform->mdlWorld;
-		data.color = glm::vec4(render->clr, 1);
-		data.texParams = glm::vec4(0, 0, 1, 1); // default, no texture frame
+		// draw in between the last two fixed steps
+		float posX = transform->x;
+		float posY = transform->y;
+		if (transform->hasPrev) {
+			posX = transform->prevX + (transform->x - transform->prevX) * alpha;
+			posY = transform->prevY + (transform->y - transform->prevY) * alpha;
+		}
+
+		// the vertex shader builds the matrix from these
+		renderer::InstanceData data; // default texParams, no texture frame
+		data.setTransform(posX, posY, transform->z, transform->rotation, scaleX, transform->scaleY);
+		data.setColor(glm::vec4(render->clr, 1));
+
+		// into the queue, sorted before anything is drawn. untextured shapes are opaque
+		auto queue = [&](const BatchKey& key, bool transparent) {
+			std::uint64_t sortKey = makeSortKey(obj->getLayer(), transparent, key.texID != 0, key.texID, key.meshType, transform->z);
+			scratch.items.push_back(QueueItem{ sortKey, key, data });
+		};
 
 		// if obj has animation & state machine component
-		if (obj->hasComponent<Animation>() && obj->hasComponent<StateMachine>())
+		if (obj->hasComponents<Animation, StateMachine>())
 		{
 			Animation* animation = obj->getComponent<Animation>();
 			StateMachine* sm = obj->getComponent<StateMachine>();
@@ -388,63 +567,205 @@ void RenderSystem::batchingSetUp(GameObjectManager& manager, float const& deltaT
 				glm::vec2 texOffSet{ as.currentFrameColumn / static_cast<float>(as.totalColumn), 1.f - ((as.currentFrameRow + 1) / static_cast<float>(as.totalRow)) };
 				glm::vec2 texScale{ 1.f / as.totalColumn, 1.f / as.totalRow };
 
-				if (as.loop)
-				{
-					as.frameTimer += deltaTime;
-					if (as.frameTimer >= as.frameTime && !EditorManager::isEditingMode() && !EditorManager::isPaused())
-					{
-						as.frameTimer -= as.frameTime;
-						if (as.currentFrameColumn >= as.lastFrame.x && as.currentFrameRow >= as.lastFrame.y)
-						{
-							as.currentFrameColumn = (int)as.initialFrame.x;
-							as.currentFrameRow = (int)as.initialFrame.y;
-							as.frameTimer = 0;
-						}
-						else
-						{
-							++as.currentFrameColumn;
-
-							if (as.currentFrameColumn >= as.totalColumn)
-							{
-								as.currentFrameColumn = 0;
-								++as.currentFrameRow;
-
-								if (as.currentFrameRow > as.lastFrame.y)
-								{
-									as.currentFrameColumn = (int)as.initialFrame.x;
-									as.currentFrameRow = (int)as.initialFrame.y;
-								}
-							}
-						}
-						/*as.currentFrameColumn = (as.currentFrameColumn + 1) % as.totalColumn;
-						as.currentFrameRow = (as.currentFrameRow + 1) % as.totalRow;*/
-						animation->runItBack = true;
-					}
-				}
-				data.texParams = { texOffSet,texScale };
-				BatchKey key{ render->modelRef.shape, as.texHDL };
-				objectWithTex[key].push_back(data);
+				data.setTexParams({ texOffSet,texScale });
+				TextureLayer layer = ResourceManager::getInstance().findTextureLayer(as.texHDL);
+				data.texLayer = static_cast<GLushort>(layer.layer);
+				// sprite sheets are cut out of their background, always blended
+				queue(BatchKey{ render->modelRef.shape, layer.array }, true);
 			}
 			// draw shape if obj texture file is empty
 			else {
-				objectWithoutTex[render->modelRef.shape].push_back(data);
+				queue(BatchKey{ render->modelRef.shape, 0 }, false);
 			}
 		}
 		else if (render->hasTex)
 		{
-			BatchKey key{ render->modelRef.shape, render->texHDL };
-			objectWithTex[key].push_back(data);
+			// everything in the same array goes out in one draw
+			TextureLayer layer = ResourceManager::getInstance().findTextureLayer(render->texHDL);
+			data.texLayer = static_cast<GLushort>(layer.layer);
+			queue(BatchKey{ render->modelRef.shape, layer.array }, render->isTransparent);
 		}
 		else
 		{
-			objectWithoutTex[render->modelRef.shape].push_back(data);
+			queue(BatchKey{ render->modelRef.shape, 0 }, false);
 		}
+	};
+
+	// only the objects in view from here on
+	jobs.parallelFor(visibleObjects.size(), objectsPerSlice, [&](const JobRange& range)
+	{
+		BatchScratch& scratch = batchScratch[range.slice];
+		for (size_t i = range.begin; i < range.end; ++i) {
+			GameObject* object = manager.getGameObject(visibleObjects[i]);
+			Transform* transform = object ? object->getComponent<Transform>() : nullptr;
+			Render* render = object ? object->getComponent<Render>() : nullptr;
+			if (!transform || !render) {
+				scratch.stale.push_back(visibleObjects[i]);
+				continue;
+			}
+			// made static after it was put in the grid
+			if (drawnStatic(*object, *render)) continue;
+			if (render->visible) ++scratch.drawn;
+			batchObject(scratch, *object, *transform, *render);
+		}
+	});
+
+	size_t drawn = 0;
+	// merge in slice order, so instances end up in the same order as a single threaded pass
+	for (size_t slice = 0; slice < slices; ++slice) {
+		for (EntityHandle handle : batchScratch[slice].stale) objectGrid.remove(handle);
+		batchScratch[slice].stale.clear();
+		drawn += batchScratch[slice].drawn;
+		batchScratch[slice].drawn = 0;
+
+		std::vector<QueueItem>& items = batchScratch[slice].items;
+		queueItems.insert(queueItems.end(), items.begin(), items.end());
+		items.clear();
+	}
+
+	cullStats.objectsVisible = drawn;
+	cullStats.objectsCulled = shown > drawn ? shown - drawn : 0;
+	cullStats.objectsReindexed = reindexed;
+
+	// after the frames above were read. every animated object steps, in view or not, so
+	// nothing off screen freezes mid cycle
+	stepAnimations(manager, deltaTime);
+
+	// the static batches in view go into the same queue, one item each. always blended,
+	// they are textured and their sprites overlap
+	for (const StaticGroup& group : staticGroups) {
+		if (group.batch.vao && group.bounds.overlaps(viewRect))
+			queueStatics.push_back(StaticDraw{ &group.batch, group.layer, group.z });
 	}
+	queueStatics.insert(queueStatics.end(), visibleTileBatches.begin(), visibleTileBatches.end());
 
+	// sorted by key only, items in the same slot keep their index order so the frame is
+	// drawn the same way every time
+	sortEntries.reserve(queueItems.size() + queueStatics.size());
+	for (size_t i = 0; i < queueItems.size(); ++i) {
+		sortEntries.push_back(SortEntry{ queueItems[i].key, static_cast<std::uint32_t>(i) });
+	}
+	for (size_t i = 0; i < queueStatics.size(); ++i) {
+		std::uint64_t key = makeSortKey(queueStatics[i].layer, true, true, 0, shape::square, queueStatics[i].z);
+		sortEntries.push_back(SortEntry{ key, static_cast<std::uint32_t>(queueItems.size() + i) });
+	}
+	radixSort64(sortEntries, sortScratch);
 	
 	//Font::init();
 }
 
+void RenderSystem::buildStaticObjects(GameObjectManager& manager)
+{
+	using Groups = std::unordered_map<BatchKey, std::vector<renderer::InstanceData>, BatchKeyHash>;
+	// one group per layer and z: a group is one item in the blended band, so its z has to be
+	// every one of its objects' for them to sort back to front against each other and the
+	// dynamic objects. built in layer then z order
+	std::map<std::pair<int, float>, std::pair<StaticGroup, Groups>> groups;
+
+	for (EntityHandle handle : staticObjects) {
+		GameObject* object = manager.getGameObject(handle);
+		Transform* transform = object ? object->getComponent<Transform>() : nullptr;
+		Render* render = object ? object->getComponent<Render>() : nullptr;
+		if (!transform || !render || !render->visible) continue;
+
+		// same as batchObject, without interpolation since it does not move
+		float scaleX = transform->flipX ? -transform->scaleX : transform->scaleX;
+		renderer::InstanceData data;
+		data.setTransform(transform->x, transform->y, transform->z, transform->rotation, scaleX, transform->scaleY);
+		data.setColor(glm::vec4(render->clr, 1));
+
+		TextureLayer layer = ResourceManager::getInstance().findTextureLayer(render->texHDL);
+		data.texLayer = static_cast<GLushort>(layer.layer);
+
+		SpatialGrid::Rect bounds = objectBounds(*transform, *render);
+		auto [it, added] = groups.try_emplace(std::make_pair(object->getLayer(), transform->z));
+		StaticGroup& group = it->second.first;
+		if (added) {
+			group.layer = object->getLayer();
+			group.z = transform->z;
+			group.bounds = bounds;
+		}
+		else {
+			group.bounds.minX = std::min(group.bounds.minX, bounds.minX);
+			group.bounds.minY = std::min(group.bounds.minY, bounds.minY);
+			group.bounds.maxX = std::max(group.bounds.maxX, bounds.maxX);
+			group.bounds.maxY = std::max(group.bounds.maxY, bounds.maxY);
+		}
+		it->second.second[BatchKey{ render->modelRef.shape, layer.array }].push_back(data);
+	}
+
+	for (StaticGroup& group : staticGroups) renderer::destroy_static_batch(group.batch);
+	staticGroups.clear();
+	for (auto& [layerAndZ, entry] : groups) {
+		staticGroups.push_back(entry.first);
+		renderer::build_static_batch(staticGroups.back().batch, entry.second);
+	}
+}
+
+void RenderSystem::drawQueue()
+{
+	// both programs read the camera from the frame data block, switching between them is only glUseProgram
+	const GLuint texProgram = renderer::shdr_pgm[0];
+	const GLuint shapeProgram = renderer::shdr_pgm[1];
+
+	queueStats = QueueStats{};
+	queueStats.items = sortEntries.size();
+
+	GLuint program = 0;
+	std::uint64_t band = ~0ull; // layer and transparent bits of what is being drawn
+	auto useProgram = [&](GLuint wanted) {
+		if (wanted == program) return;
+		renderer::submitDrawList();
+		glUseProgram(wanted);
+		program = wanted;
+		++queueStats.programSwitches;
+	};
+
+	const std::uint64_t bandMask = ~0ull << KEY_TRANSPARENT_SHIFT;
+	size_t i = 0;
+	while (i < sortEntries.size()) {
+		const SortEntry& entry = sortEntries[i];
+
+		if ((entry.key & bandMask) != band) {
+			renderer::submitDrawList();
+			bool newLayer = band == ~0ull || (entry.key >> KEY_LAYER_SHIFT) != (band >> KEY_LAYER_SHIFT);
+			if (newLayer) ++queueStats.layers;
+			// blended draws are already back to front, they test depth but do not write it
+			bool transparent = ((entry.key >> KEY_TRANSPARENT_SHIFT) & 1) != 0;
+			glDepthMask(transparent ? GL_FALSE : GL_TRUE);
+			band = entry.key & bandMask;
+		}
+
+		// a static batch, drawn right away so what is queued before it has to go first
+		if (entry.index >= queueItems.size()) {
+			useProgram(texProgram);
+			renderer::submitDrawList();
+			renderer::draw_static_batch(*queueStatics[entry.index - queueItems.size()].batch);
+			++queueStats.runs;
+			++i;
+			continue;
+		}
+
+		// the run: the items after it in the same band with the same mesh and texture
+		const QueueItem& first = queueItems[entry.index];
+		runInstances.clear();
+		size_t end = i;
+		while (end < sortEntries.size() && sortEntries[end].index < queueItems.size()
+			&& (sortEntries[end].key & bandMask) == band && queueItems[sortEntries[end].index].batch == first.batch) {
+			runInstances.push_back(queueItems[sortEntries[end].index].data);
+			++end;
+		}
+
+		useProgram(first.batch.texID ? texProgram : shapeProgram);
+		renderer::queueInstances(renderer::models[static_cast<int>(first.batch.meshType)], runInstances, first.batch.texID);
+		++queueStats.runs;
+		i = end;
+	}
+
+	renderer::submitDrawList();
+	glDepthMask(GL_TRUE);
+}
+
 //this moved to ResourceManager.cpp
 // Upload a texture from file and return its OpenGL handle
 //GLuint RenderSystem::uploadtex(std::string const& filename, bool& isTransparent)
@@ -475,129 +796,6 @@ void RenderSystem::batchingSetUp(GameObjectManager& manager, float const& deltaT
 //	return texobj_hdl;
 //}
 
-void RenderSystem::renderTex(GameObject* object, float const& deltaTime)
-{
-	if (object->hasComponent<Render>() && object->hasComponent<Transform>())
-	{
-		Transform* transform = object->getComponent<Transform>();
-		Render* render = object->getComponent<Render>();
-
-		//position and orientation of mesh
-		float angle = glm::radians(transform->rotation);
-		transform->mdlWorld = glm::mat4{ 1 };
-		transform->mdlWorld = glm::translate(transform->mdlWorld, glm::vec3(transform->x, transform->y, transform->z));
-		transform->mdlWorld = glm::rotate(transform->mdlWorld, angle, glm::vec3(0, 0, 1.f));
-		transform->mdlWorld = glm::scale(transform->mdlWorld, glm::vec3(transform->scaleX, transform->scaleY, transform->scaleZ));
-
-		glBindTextureUnit(0, render->texHDL);
-		//std::cerr << "Binding Texture ID: " << render->texHDL << " for object: " << object->getObjectName() << std::endl;
-
-		glm::mat4 texRot{ 1 };
-		texRot = glm::rotate(texRot, angle, glm::vec3(0, 0, 1.f));
-		glm::vec2 rotationCenter{ 0,0 }; //if needed in the future it can be a member variable, now just for sanity
-
-		//binding model to world matrix
-		glBindVertexArray(render->modelRef.vaoid);
-		GLint vTransformLoc = glGetUniformLocation(renderer::shdr_pgm[0], "M");
-		glUniformMatrix4fv(vTransformLoc, 1, GL_FALSE, glm::value_ptr(transform->mdlWorld));
-
-		glm::vec2 texpos, texscale;
-		if (render->hasAnimation)
-		{
-			Animation* animation = object->getComponent<Animation>();
-			if (StateMachine* sm = object->getComponent<StateMachine>()) {
-				AnimateState& as = animation->animState[static_cast<int>(sm->state)];
-				if (!as.texFile.empty()) {
-					texpos = glm::vec2{ as.currentFrameColumn / static_cast<float>(as.totalColumn), as.currentFrameRow / static_cast<float>(as.totalRow) };
-					texscale = glm::vec2{ 1.f / as.totalColumn, 1.f / as.totalRow };
-					if (as.loop)
-					{
-						as.frameTimer += deltaTime;
-						//std::cout << "\n-------Frame Timer---------\n" << animation->frameTimer << "\n\n";
-						if (as.frameTimer >= as.frameTime && !EditorManager::isEditingMode() && !EditorManager::isPaused())
-						{
-							as.frameTimer -= as.frameTime;
-							/*if (animation->runItBack && animation->currentFrameColumn == 0)
-							{
-								animation->runItBack = false;
-							}
-							else
-							{
-								animation->currentFrameColumn = (animation->currentFrameColumn + 1) % animation->totalColumn;
-								animation->currentFrameRow = (animation->currentFrameRow + 1) % animation->totalRow;
-								animation->runItBack = true;
-							}*/
-							as.currentFrameColumn = (as.currentFrameColumn + 1) % as.totalColumn;
-							as.currentFrameRow = (as.currentFrameRow + 1) % as.totalRow;
-							animation->runItBack = true;
-
-						}
-					}
-				}
-			}
-		}
-		else
-		{
-			texpos = glm::vec2{ 0,0 };
-			texscale = glm::vec2{ 1,1 };
-		}
-		//binding texture rotation and id
-		GLint texid = glGetUniformLocation(renderer::shdr_pgm[0], "uTex2d");
-		GLint rotmat = glGetUniformLocation(renderer::shdr_pgm[0], "uRotMtx");
-		GLint rotcenter = glGetUniformLocation(renderer::shdr_pgm[0], "uMcn");
-		GLint offset = glGetUniformLocation(renderer::shdr_pgm[0], "uTexOffSet");
-		GLint tscale = glGetUniformLocation(renderer::shdr_pgm[0], "uTexScale");
-		glUniform1i(texid, 0);
-		glUniformMatrix2fv(rotmat, 1, GL_FALSE, glm::value_ptr(texRot));
-		glUniform2fv(rotcenter, 1, glm::value_ptr(rotationCenter));
-		glUniform2fv(offset, 1, glm::value_ptr(texpos));
-		glUniform2fv(tscale, 1, glm::value_ptr(texscale));
-
-		if (render->modelRef.shape == shape::square)
-		{
-			// --- Pass 1: textured fill ---
-			glBindVertexArray(render->modelRef.vaoid);
-			glDrawElements(GL_TRIANGLES, render->modelRef.elem_cnt, GL_UNSIGNED_SHORT, nullptr);
-		}
-		//glDrawElements(GL_TRIANGLES, render->modelRef.elem_cnt, GL_UNSIGNED_SHORT, nullptr);
-		else if (render->modelRef.shape == shape::circle)
-			glDrawArrays(render->modelRef.primitive_type, 0, render->modelRef.draw_cnt);
-		glBindVertexArray(0);
-	}
-}
-
-void RenderSystem::renderNoTex(GameObject* object)
-{
-	if (object->hasComponent<Render>() && object->hasComponent<Transform>())
-	{
-		Transform* transform = object->getComponent<Transform>();
-		Render* render = object->getComponent<Render>();
-
-		//position and orientation of mesh
-		float angle = glm::radians(transform->rotation);
-		transform->mdlWorld = glm::mat4{ 1 };
-		transform->mdlWorld = glm::translate(transform->mdlWorld, glm::vec3(transform->x, transform->y, transform->z));
-		transform->mdlWorld = glm::rotate(transform->mdlWorld, angle, glm::vec3(0, 0, 1.f));
-		transform->mdlWorld = glm::scale(transform->mdlWorld, glm::vec3(transform->scaleX, transform->scaleY, transform->scaleZ));
-		glBindTextureUnit(0, 0);
-
-		glm::mat4 texRot{ 1 };
-		texRot = glm::rotate(texRot, angle, glm::vec3(0, 0, 1.f));
-		glm::vec2 rotationCenter{ 0,0 }; //if needed in the future it can be a member variable, now just for sanity
-
-		//binding model to world matrix
-		glBindVertexArray(render->modelRef.vaoid);
-		GLint vTransformLoc = glGetUniformLocation(renderer::shdr_pgm[1], "M");
-		glUniformMatrix4fv(vTransformLoc, 1, GL_FALSE, glm::value_ptr(transform->mdlWorld));
-
-		if (render->modelRef.shape == shape::square)
-			glDrawElements(GL_TRIANGLES, render->modelRef.elem_cnt, GL_UNSIGNED_SHORT, nullptr);
-		else if (render->modelRef.shape == shape::circle)
-			glDrawArrays(render->modelRef.primitive_type, 0, render->modelRef.draw_cnt);
-		glBindVertexArray(0);
-	}
-}
-
 void RenderSystem::fboAspectRatio(int& width, int& height) const {
 	width = fboWidth;
 	height = fboHeight;
@@ -649,24 +847,25 @@ void RenderSystem::fboAspectRatio(int& width, int& height) const {
 //	}
 //}
 
-void FontSystem::init(GameObjectManager& manager)
+namespace {
+	// RGBA8 like renderer::InstanceData, text is always opaque
+	GLuint packTextColor(const glm::vec3& color)
+	{
+		GLuint packed = 0xFF000000u;
+		for (int i = 0; i < 3; ++i) {
+			packed |= static_cast<GLuint>(std::lround(glm::clamp(color[i], 0.f, 1.f) * 255.f)) << (i * 8);
+		}
+		return packed;
+	}
+}
+
+void FontSystem::init()
 {
 	Font::init();
 
 	ResourceManager::getInstance().getFont("assets/Orange Knight.ttf");
 	ResourceManager::getInstance().getFont("assets/ARIAL.TTF");
 	ResourceManager::getInstance().getFont("assets/times.ttf");
-
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-	for (GameObject* object : gameObjects)
-	{
-		if (object->hasComponent<FontComponent>())
-		{
-			FontComponent* fc = object->getComponent<FontComponent>();
-			fc->mdl = Font::fontMdls[0];
-		}
-	}
 }
 
 void FontSystem::update(GameObjectManager& manager, double fps)
@@ -677,9 +876,6 @@ void FontSystem::update(GameObjectManager& manager, double fps)
 	//record current time for performance tracking
 	auto start = std::chrono::high_resolution_clock::now();
 
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-
 	// Count font objects
 	/*int fontCount = 0;
 	for (GameObject* object : gameObjects) {
@@ -698,7 +894,7 @@ void FontSystem::update(GameObjectManager& manager, double fps)
 		return;
 	}*/
 
-	glUseProgram(Font::fontShaders);
+	for (GlyphBatch& batch : glyphBatches) batch.glyphs.clear();
 
 	glm::mat4 camView, camProj;
 	if (UISystem::isShowUI()) {
@@ -710,124 +906,125 @@ void FontSystem::update(GameObjectManager& manager, double fps)
 		camProj = renderer::cam.proj;
 	}
 
-	GLuint vTransformView = glGetUniformLocation(Font::fontShaders, "V");
-	glUniformMatrix4fv(vTransformView, 1, GL_FALSE, glm::value_ptr(camView));
-	GLuint vTransformProj = glGetUniformLocation(Font::fontShaders, "P");
-	glUniformMatrix4fv(vTransformProj, 1, GL_FALSE, glm::value_ptr(camProj));
-	for (GameObject* object : gameObjects)
+	// text can follow the editor camera while the scene is drawn with the game one
+	renderer::updateFrameCamera(camView, camProj);
+	manager.each<FontComponent, Transform>([this](GameObject& object, FontComponent& fc, Transform& transform)
 	{
-		if (object->hasComponent<FontComponent>())
-		{
-			FontComponent* fc = object->getComponent<FontComponent>();
-			Transform* transform = object->getComponent<Transform>();
-			RenderText(Font::fontShaders, fc->word, transform->x, transform->y, fc->scale, fc->clr, object);
-		}
-	}
+		RenderText(fc.word, transform.x, transform.y, fc.scale, fc.clr, fc.fontType);
+	});
 
 	/* ---- scuffed way to render fps for M3 ---- */
 	if (showFPS) {
-		std::unique_ptr<GameObject> fpsText = manager.createTempGameObject("fpsText");
-		if (Transform* t = fpsText->addComponent<Transform>()) {
-			if (FontComponent* fc = fpsText->addComponent<FontComponent>()) {
-				fc->word = "FPS: " + std::to_string(fps);
-				t->x = -15.f;
-				t->y = 9.f;
-				RenderText(Font::fontShaders, fc->word, t->x, t->y, fc->scale, fc->clr, fpsText.get());
-			}
-		}
+		// no object for it, just the text into a string kept from frame to frame, black arial
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "FPS: %f", fps);
+		fpsText.assign(buffer);
+		RenderText(fpsText, -15.f, 9.f, 1.f, glm::vec3{ 0.f, 0.f, 0.f }, 1);
 	}
 	/* ---- END ---- */
 
+	drawGlyphs();
+
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count(); //get elapse time in ms
-	g_SystemTimers.push_back({ "Font", ms }); //saving timing for UI output
+	PushSystemTimer("Font", ms); //saving timing for UI output
 }
 
-void FontSystem::RenderText(GLuint& s, std::string text, float x, float y, float scale, glm::vec3 color, GameObject* object)
+void FontSystem::RenderText(const std::string& text, float x, float y, float scale, glm::vec3 color, int fontType)
 {
-	// activate corresponding render state	
-	FontComponent* fc = object->getComponent<FontComponent>();
-	Font::FontMdl& mdl = fc->mdl;
+	// built once, "assets/Orange Knight.ttf" is too long to build without allocating every call
+	static const std::string orangeKnight = "assets/Orange Knight.ttf";
+	static const std::string arial = "assets/ARIAL.TTF";
+	static const std::string times = "assets/times.ttf";
+
+	const std::string* fontPath;
+	switch (fontType) {
+	case 0: fontPath = &orangeKnight; break;
+	case 1: fontPath = &arial; break;
+	case 2: fontPath = &times; break;
+	default: fontPath = &arial; break;
+	}
 
-	//Font::FontMdl& mdl = object->getComponent<FontComponent>()->mdl;
-	//^mans trolling here
-	
-	std::string fontPath;
-	switch (fc->fontType) {
-	case 0: fontPath = "assets/Orange Knight.ttf"; break;
-	case 1: fontPath = "assets/ARIAL.TTF"; break;
-	case 2: fontPath = "assets/times.ttf"; break;
-	default: fontPath = "assets/ARIAL.TTF"; break;
+	const FontData& fontData = ResourceManager::getInstance().getFont(*fontPath);
+	if (!fontData.atlas) return;
+
+	// a handful of fonts at most, a list is quicker than a map
+	auto batch = std::find_if(glyphBatches.begin(), glyphBatches.end(),
+		[&fontData](const GlyphBatch& candidate) { return candidate.atlas == fontData.atlas; });
+	if (batch == glyphBatches.end()) {
+		glyphBatches.push_back(GlyphBatch{ fontData.atlas, {} });
+		batch = glyphBatches.end() - 1;
 	}
 
-	const FontData& fontData = ResourceManager::getInstance().getFont(fontPath);
+	const GLuint packedColor = packTextColor(color);
+	const float pxToWorld = (2.0f * renderer::cam.zoom) / (renderer::cam.width / renderer::cam.ar);
 
-	/*std::cout << "FontData has " << fontData.characters.size() << " characters loaded" << std::endl;
-	if (fontData.characters.empty()) {
-		std::cerr << "ERROR: Font data has NO characters!" << std::endl;
-		return;
-	}*/
+	// iterate through all characters
+	for (char c : text)
+	{
+		auto it = fontData.characters.find(static_cast<unsigned char>(c));
+		if (it == fontData.characters.end()) continue;
+		const Font::Character& ch = it->second;
 
-	// --- Add this block --- //for text to be on top of everything
+		// spaces only move the cursor
+		if (ch.Size.x > 0 && ch.Size.y > 0) {
+			Font::GlyphInstance glyph;
+			glyph.rect.x = x + (ch.Bearing.x * pxToWorld) * scale;
+			glyph.rect.y = y - ((ch.Size.y - ch.Bearing.y) * pxToWorld) * scale;
+			glyph.rect.z = (ch.Size.x * pxToWorld) * scale;
+			glyph.rect.w = (ch.Size.y * pxToWorld) * scale;
+			glyph.uv = ch.uvRect;
+			glyph.color = packedColor;
+			batch->glyphs.push_back(glyph);
+		}
+
+		// now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+		x += ((ch.Advance >> 6) * pxToWorld) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
+	}
+}
+
+void FontSystem::drawGlyphs()
+{
+	textStats = TextStats{};
+
+	uploadScratch.clear();
+	for (const GlyphBatch& batch : glyphBatches) {
+		uploadScratch.insert(uploadScratch.end(), batch.glyphs.begin(), batch.glyphs.end());
+	}
+	textStats.glyphs = uploadScratch.size();
+	if (uploadScratch.empty() || Font::fontMdls.empty()) return;
+
+	// a new store every frame, the driver swaps it in without waiting on last frame's draws
+	const Font::FontMdl& mdl = Font::fontMdls[0];
+	glNamedBufferData(mdl.vbo, static_cast<GLsizeiptr>(uploadScratch.size() * sizeof(Font::GlyphInstance)),
+		uploadScratch.data(), GL_STREAM_DRAW);
+
+	//for text to be on top of everything
 	glDisable(GL_DEPTH_TEST);
 	glDepthMask(GL_FALSE);
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	// ----------------------
 
-	glUseProgram(s);
-	glUniform3f(glGetUniformLocation(s, "textColor"), color.x, color.y, color.z);
-	glActiveTexture(GL_TEXTURE0);
+	glUseProgram(Font::fontShaders);
 	glBindVertexArray(mdl.vao);
 
-	// iterate through all characters
-	std::string::const_iterator c;
-	for (c = text.begin(); c != text.end(); c++)
-	{
-		unsigned char uc = static_cast<unsigned char>(*c);
-		auto it = fontData.characters.find(uc);
-		//if (it == fontData.characters.end()) {
-		//	std::cerr << "Character '" << uc << "' not found in font '" << fontPath << "'\n";
-		//	continue; // skip character if not found
-		//}
-
-		const Font::Character& ch = it->second;
-		//Font::Character ch = Font::characters[fc->fontType][*c];
-
-		float pxToWorld = (2.0f * renderer::cam.zoom) / (renderer::cam.width / renderer::cam.ar);
-		float xpos = x + (ch.Bearing.x * pxToWorld) * scale;
-		float ypos = y - ((ch.Size.y - ch.Bearing.y) * pxToWorld) * scale;
-		//float ypos = y - (ch.Bearing.y * pxToWorld) * scale;
-
-		float w = (ch.Size.x * pxToWorld) * scale;
-		float h = (ch.Size.y * pxToWorld) * scale;
-		// update VBO for each character
-		float vertices[6][4] = {
-			{ xpos,     ypos + h,   0.0f, 0.0f },
-			{ xpos,     ypos,       0.0f, 1.0f },
-			{ xpos + w, ypos,       1.0f, 1.0f },
-
-			{ xpos,     ypos + h,   0.0f, 0.0f },
-			{ xpos + w, ypos,       1.0f, 1.0f },
-			{ xpos + w, ypos + h,   1.0f, 0.0f }
-		};
-		// render glyph texture over quad
-		glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-		// update content of VBO memory
-		glBindBuffer(GL_ARRAY_BUFFER, mdl.vbo);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		// render quad
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-		// now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-		x += ((ch.Advance >> 6) * pxToWorld) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
+	// fonts draw one after the other, text in different fonts overlapping goes by font
+	GLuint first = 0;
+	for (const GlyphBatch& batch : glyphBatches) {
+		if (batch.glyphs.empty()) continue;
+		const GLsizei count = static_cast<GLsizei>(batch.glyphs.size());
+		glBindTextureUnit(0, batch.atlas);
+		glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, count, first);
+		first += static_cast<GLuint>(count);
+		++textStats.drawCalls;
 	}
+
 	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindTextureUnit(0, 0);
 
-	// --- Restore state --- //for text to be on top of everything
+	// --- Restore state ---
 	glDepthMask(GL_TRUE);
 	glEnable(GL_DEPTH_TEST);
 }
@@ -864,31 +1061,18 @@ void PhysicsSystem::update(GameObjectManager& manager, const float& deltaTime, M
 	if (m_stepReq)
 		m_stepReq = false;*/
 
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-
-	std::unordered_map<GameObject*, bool> previousOnGround;
-	for (auto object : gameObjects) {
-		if (!object->hasComponent<Physics>()) continue;
-		Physics* physics = object->getComponent<Physics>();
-		previousOnGround[object] = physics->onGround;
-	}
-
-	for (auto object : gameObjects) {
-		if (!object->hasComponent<Physics>()) continue;
-		Physics* physics = object->getComponent<Physics>();
-		physics->onGround = false;
-	}
+	m_wasOnGround.clear();
+	manager.each<Physics>([&](GameObject& object, Physics& physics) {
+		if (physics.onGround) m_wasOnGround.push_back(&object);
+		physics.onGround = false;
+	});
 
-	for (auto object : gameObjects) {
-		if (!object->hasComponent<Transform>() || !object->hasComponent<Physics>())
-			continue;
-
-		Physics* physics = object->getComponent<Physics>();
-		if (object->getObjectName() == "bullet") continue;
-		if (!physics->physicsFlag) continue;
+	manager.each<Transform, Physics>([&](GameObject& objectRef, Transform& transformRef, Physics& physicsRef) {
+		GameObject* object = &objectRef;
+		Physics* physics = &physicsRef;
+		if (!physics->physicsFlag) return;
 		//if (physics->isStatic) continue;
-		Transform* transform = object->getComponent<Transform>();
+		Transform* transform = &transformRef;
 
 		// Handle player input
 		if (object->hasComponent<Input>() && !EditorManager::isEditingMode() && !EditorManager::isPaused()) {
@@ -897,19 +1081,23 @@ void PhysicsSystem::update(GameObjectManager& manager, const float& deltaTime, M
 				PhysicsForces::updatePosition(transform, physics, deltaTime);
 			}
 
-			if (InputHandler::isKeyTriggered(GLFW_KEY_SPACE)) {
-				GameObject* bullet = PhysicsForces::findAvailableBullet(manager);
+			if (InputHandler::isKeyTriggeredThisStep(GLFW_KEY_SPACE)) {
+				GameObject* bullet = PhysicsForces::acquireBullet(manager);
 				//debugBullets(manager);
 				if (bullet != nullptr) {
-					PhysicsForces::shoot(bullet, transform);
+					// the bullet is another object in this same loop, activate it at the sync point
+					// instead so it starts moving next frame no matter where it sits in the storage
+					Transform origin = *transform;
+					manager.getCommandBuffer().invoke(bullet->getHandle(), [origin](GameObject& activated) {
+						PhysicsForces::shoot(&activated, &origin);
+
+						if (AudioComponent* audio = activated.getComponent<AudioComponent>()) {
+							AudioChannel* ch = audio->getDefaultChannel();
+							ch->isPendingPlay = true;
+						}
+					});
 					messageBus.publish(Message("KeyPressed", nullptr, KeyEvent{ "SPACE", true }));
 
-					if (bullet->hasComponent<AudioComponent>()) {
-						AudioComponent* audio = bullet->getComponent<AudioComponent>();
-						AudioChannel* ch = audio->getDefaultChannel();
-						ch->isPendingPlay = true;
-					}
-
 					DebugLog::addMessage("Bullet fired from pool!", DebugMode::PlaySimul);
 				}
 				else {
@@ -931,8 +1119,8 @@ void PhysicsSystem::update(GameObjectManager& manager, const float& deltaTime, M
 			physics->dynamics.velocity.x = targetVelX;
 
 			// Jump
-			if (InputHandler::isKeyTriggered(GLFW_KEY_B)) {
-				if (previousOnGround[object]) {
+			if (InputHandler::isKeyTriggeredThisStep(GLFW_KEY_B)) {
+				if (std::find(m_wasOnGround.begin(), m_wasOnGround.end(), object) != m_wasOnGround.end()) {
 					PhysicsForces::jump(object);
 					messageBus.publish(Message("KeyPressed", nullptr, KeyEvent{ "B", true }));
 				}
@@ -949,56 +1137,60 @@ void PhysicsSystem::update(GameObjectManager& manager, const float& deltaTime, M
 				//physics->velX = 0.0f;
 			}
 			transform->x += physics->velX * deltaTime;
+			transform->markDirty(); // moved and/or flipped
 		}
 
 		// Auto-move objects
 		if (object->checkAutoMove()) {
 			transform->y += physics->dynamics.velocity.y * deltaTime;
 			transform->x += physics->dynamics.velocity.x * deltaTime;
+			transform->markDirty();
 		}
-	}
-
-	for (GameObject* obj : gameObjects) { 
-		std::string name = obj->getObjectName();
+	});
 
-		// Skip if not a numbered bullet
-		if (name.find("bullet") != 0 || name.length() <= 6) continue;
-
-		// Check if it's a numbered bullet (bullet1, bullet2, etc.)
-		bool isNumberedBullet = true;
-		for (size_t i = 6; i < name.length(); i++) {
-			if (!std::isdigit(name[i])) {
-				isNumberedBullet = false;
-				break;
-			}
-		}
-		if (!isNumberedBullet) continue;
-
-		if (!obj->hasComponent<Physics>() || !obj->hasComponent<Transform>())
-			continue;
+	// pooled objects in flight (bullets) only touch their own components, integrate them on the job system.
+	// the pool's active list is all of them, no need to look at anything else
+	ObjectPool& pool = manager.getPrefabPool();
+	m_pooledBodies.clear();
+	for (EntityHandle handle : pool.getActive()) {
+		GameObject* obj = manager.getGameObject(handle);
+		if (!obj) continue;
 
 		Physics* p = obj->getComponent<Physics>();
 		Transform* t = obj->getComponent<Transform>();
+		if (p && t && p->alive) m_pooledBodies.push_back(PooledBody{ obj, t, p });
+	}
+
+	JobSystem::getInstance().parallelFor(m_pooledBodies.size(), 16, [&](const JobRange& range) {
+		for (size_t i = range.begin; i < range.end; ++i) {
+			PooledBody& body = m_pooledBodies[i];
+			Physics* p = body.physics;
+			Transform* t = body.transform;
 
-		if (p->alive) {
 			// Update bullet physics
 			DynamicsSystem::Integrate(p->dynamics, deltaTime, 0.0f, false);
 			t->x = p->dynamics.position.x;
 			t->y = p->dynamics.position.y;
+			t->markDirty();
 
 			// Update life timer
 			p->lifeTimer += deltaTime;
 
 			// Deactivate if lifetime exceeded
 			if (p->lifeTimer >= p->maxLifetime) {
-				PhysicsForces::deactivateBullet(obj);
+				PhysicsForces::deactivateBullet(body.object);
 			}
 		}
-	} 
+	});
+
+	// the ones that ran out go back to the pool
+	for (PooledBody& body : m_pooledBodies) {
+		if (!body.physics->alive) pool.release(manager, body.object->getHandle());
+	}
 
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count();
-	g_SystemTimers.push_back({ "Physics", ms });
+	PushSystemTimer("Physics", ms);
 }
 
 
@@ -1010,11 +1202,19 @@ void CollisionSystem::update(GameObjectManager& manager, const float& deltaTime)
 
 	//get layer manager
 	LayerManager& layerManager = manager.getLayerManager();
-	std::vector<Layer*> layers = layerManager.getAllLayers();
+	layerManager.getAllLayers(m_layers);
+
+	//stream every collider once out of storage and bucket it by layer. the buckets
+	//stay in the map with their capacity, only emptied
+	for (auto& bucket : m_collidersByLayer) bucket.second.clear();
+	manager.each<CollisionInfo, Transform, Render>([&](GameObject& obj, CollisionInfo& c, Transform&, Render&) {
+		if (!c.collisionFlag) return; // skip if obj not supposed to collide
+		m_collidersByLayer[obj.getLayer()].push_back(&obj);
+	});
 
 	//process each layer separately
 	//right now only layer 1 should have any sort of collision
-	for (Layer* layer : layers) {
+	for (Layer* layer : m_layers) {
 		//skip missing layer
 		if (!layer) {
 			/*auto end = std::chrono::high_resolution_clock::now();
@@ -1024,20 +1224,17 @@ void CollisionSystem::update(GameObjectManager& manager, const float& deltaTime)
 			return;
 		}
 
-		const std::vector<GameObject*>& layerObjects = layer->getObjects();
-
-		//create grid
-		const float CELL_SIZE = 2.0f;
-		const int GRID_WIDTH = 20;
-		const int GRID_HEIGHT = 20;
-		std::vector<std::vector<Collision::Cell>> grid(GRID_WIDTH, std::vector<Collision::Cell>(GRID_HEIGHT));
+		const std::vector<GameObject*>& layerObjects = m_collidersByLayer[layer->getLayerID()];
 
+		//empty the grid, the cells keep their capacity
+		for (std::vector<Collision::Cell>& column : m_grid) {
+			for (Collision::Cell& cell : column) cell.objects.clear();
+		}
+		m_cellRanges.clear();
 
-		for (GameObject* obj : layerObjects) {
-			if (!obj->getComponent<CollisionInfo>() || !obj->hasComponent<Transform>() || !obj->hasComponent<Render>()) continue;
+		for (size_t index = 0; index < layerObjects.size(); ++index) {
+			GameObject* obj = layerObjects[index];
 			CollisionInfo* c = obj->getComponent<CollisionInfo>();
-			if (!c->collisionFlag) continue; // skip if obj not supposed to collide
-
 			Transform* objT = obj->getComponent<Transform>();
 			//Render* renderS = obj->getComponent<Render>();
 			//Collision::AABB box = Collision::getObjectAABB(objT);
@@ -1073,25 +1270,23 @@ void CollisionSystem::update(GameObjectManager& manager, const float& deltaTime)
 			//putting the object into the grid cells it occupies
 			for (int x = minCellX; x <= maxCellX; ++x) {
 				for (int y = minCellY; y <= maxCellY; ++y) {
-					grid[x][y].objects.push_back(obj);
+					m_grid[x][y].objects.push_back(index);
 				}
 			}
+			m_cellRanges.push_back(CellRange{ minCellX, maxCellX, minCellY, maxCellY });
 		}
 
-		//temporary container to track checked objects for this frame
-		//to advoid duplicate checks
-		std::unordered_map<GameObject*, std::vector<GameObject*>> checked;
-
 		//checking collision 
 		//record current time for performance tracking
 		auto start = std::chrono::high_resolution_clock::now();
 		for (int i = 0; i < GRID_WIDTH; i++) {
 			for (int j = 0; j < GRID_HEIGHT; j++) {
-				auto& cellObject = grid[i][j].objects; //get objects in the cell
+				auto& cellObject = m_grid[i][j].objects; //get objects in the cell
 				//loop through objects in the cell to check for collision
 				for (size_t n = 0; n < cellObject.size(); n++) {
 					//object 1
-					GameObject* obj1 = cellObject[n];
+					GameObject* obj1 = layerObjects[cellObject[n]];
+					const CellRange& range1 = m_cellRanges[cellObject[n]];
 					if (!obj1->hasComponent<Physics>()) continue;
 					
 					Transform* t1 = obj1->getComponent<Transform>();
@@ -1103,15 +1298,13 @@ void CollisionSystem::update(GameObjectManager& manager, const float& deltaTime)
 					//object 2 looping
 					for (size_t m = n + 1; m < cellObject.size(); m++) {
 						//object 2
-						GameObject* obj2 = cellObject[m];
+						GameObject* obj2 = layerObjects[cellObject[m]];
 						if (!obj2->hasComponent<Physics>()) continue;
 
-						//skip if already checked
-						auto it = std::find(checked[obj1].begin(), checked[obj1].end(), obj2);
-						if (it != checked[obj1].end()) continue;
-						//mark as checked both ways
-						checked[obj1].push_back(obj2);
-						checked[obj2].push_back(obj1);
+						//skip if already checked: a pair sharing several cells is only
+						//checked in the first of them the loops reach
+						const CellRange& range2 = m_cellRanges[cellObject[m]];
+						if (i != std::max(range1.minX, range2.minX) || j != std::max(range1.minY, range2.minY)) continue;
 						Transform* t2 = obj2->getComponent<Transform>();
 						//to get obj1 shape
 						CollisionInfo* c2 = obj2->getComponent<CollisionInfo>();
@@ -1155,6 +1348,9 @@ void CollisionSystem::update(GameObjectManager& manager, const float& deltaTime)
 							// c1 is the moving obj (player), c2 is the obj it collide with
 							// CASE 1: collided obj is pushable
 							if (c2->collisionRes == CollisionResponseMode::MoveWhenCollide) {
+								t1->markDirty();
+								t2->markDirty();
+
 								if (info.normal.x != 0) {
 									// move both obj away from each other (to simulate push)
 									t1->x += info.normal.x * info.penetration * 0.5f;
@@ -1181,6 +1377,8 @@ void CollisionSystem::update(GameObjectManager& manager, const float& deltaTime)
 							}
 							// CASE 2: collided obj is static
 							else if (c2->collisionRes == CollisionResponseMode::StopWhenCollide) {
+								t1->markDirty();
+
 								// Resolve penetration
 								if (info.normal.x != 0) {
 									// push moving obj out of collided obj
@@ -1221,7 +1419,7 @@ void CollisionSystem::update(GameObjectManager& manager, const float& deltaTime)
 		auto end = std::chrono::high_resolution_clock::now();
 		ms += std::chrono::duration<double, std::milli>(end - start).count(); //get elapse time in ms
 	}
-	g_SystemTimers.push_back({ "Collisions", ms }); //saving timing for UI output
+	PushSystemTimer("Collisions", ms); //saving timing for UI output
 }
 
 #ifdef _DEBUG
@@ -1263,9 +1461,6 @@ void UISystem::update(GameObjectManager& manager) {
 	//record current time for performance tracking
 	auto start = std::chrono::high_resolution_clock::now();
 
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
 	ImGui::NewFrame();
@@ -1287,7 +1482,7 @@ void UISystem::update(GameObjectManager& manager) {
 
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count(); //get elapse time in ms
-	g_SystemTimers.push_back({"IMGUI", ms }); //saving timing for UI output
+	PushSystemTimer("IMGUI", ms); //saving timing for UI output
 }
 
 void UISystem::dockingSetUp() {
@@ -1380,32 +1575,22 @@ void UISystem::renderMultipleViewPorts() {
 #endif
 
 void LogicSystem::update(GameObjectManager& manager, float const& dt) {
-
-	std::vector<GameObject*> objs;
-	manager.getAllGameObjects(objs);
-
-	static LogicContainer container; // stateless helper
-
-	for (auto* go : objs) {
-		if (!go) continue;
-		if (!go->hasComponent<StateMachine>()) continue;
-		if (!go->hasComponent<Transform>() || !go->hasComponent<Physics>()) continue;
-
-		container.update(*go, dt /*, manager */);
-	}
+	// components added on a state change (e.g. audio) are deferred, so the view can be walked directly
+	EntityCommandBuffer& commands = manager.getCommandBuffer();
+	manager.each<StateMachine, Transform, Physics>([&](GameObject& go, StateMachine&, Transform&, Physics&) {
+		m_container.update(go, dt, commands);
+	});
 }
 
 void AudioSystem::init(GameObjectManager& manager) {
 	auto start = std::chrono::high_resolution_clock::now();
 
 	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
+	manager.view<AudioComponent>().collect(gameObjects);
 
 	AudioHandler& audioHandler = AudioHandler::getInstance();
 
 	for (GameObject* obj : gameObjects) {
-		if (!obj->hasComponent<AudioComponent>()) continue;
-
 		AudioComponent* audio = obj->getComponent<AudioComponent>();
 
 		AudioChannel* ch = audio->getDefaultChannel();
@@ -1436,14 +1621,14 @@ void AudioSystem::init(GameObjectManager& manager) {
 
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count();
-	g_SystemTimers.push_back({ "Audio Init", ms });
+	PushSystemTimer("Audio Init", ms);
 }
 
 void AudioSystem::update(GameObjectManager& manager, float deltaTime) {
 	auto start = std::chrono::high_resolution_clock::now();
 
 	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
+	manager.view<AudioComponent>().collect(gameObjects);
 
 	AudioHandler& audioHandler = AudioHandler::getInstance();
 
@@ -1517,7 +1702,7 @@ void AudioSystem::update(GameObjectManager& manager, float deltaTime) {
 
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count();
-	g_SystemTimers.push_back({ "Audio", ms });
+	PushSystemTimer("Audio", ms);
 }
 
 /*
@@ -1606,13 +1791,11 @@ void AudioSystem::processAudio(GameObject* obj, AudioChannel* audio, float delta
 
 void AudioSystem::cleanup(GameObjectManager& manager) {
 	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
+	manager.view<AudioComponent>().collect(gameObjects);
 
 	AudioHandler& audioHandler = AudioHandler::getInstance();
 	
 	for (GameObject* obj : gameObjects) {
-		if (!obj->hasComponent<AudioComponent>()) continue;
-
 		AudioComponent* audio = obj->getComponent<AudioComponent>();
 
 		for (auto& pair : audio->audioChannels) {
@@ -1632,11 +1815,9 @@ void AudioSystem::initializeSceneAudio(GameObjectManager& manager) {
 	auto start = std::chrono::high_resolution_clock::now();
 
 	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
+	manager.view<AudioComponent>().collect(gameObjects);
 
 	for (GameObject* obj : gameObjects) {
-		if (!obj->hasComponent<AudioComponent>()) continue;
-
 		AudioComponent* audio = obj->getComponent<AudioComponent>();
 
 		// Pre-load all sounds for all channels
@@ -1661,5 +1842,5 @@ void AudioSystem::initializeSceneAudio(GameObjectManager& manager) {
 
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count();
-	g_SystemTimers.push_back({ "Audio Scene Init", ms });
+	PushSystemTimer("Audio Scene Init", ms);
 }
@@ -0,0 +1,212 @@
+/* Start Header ************************************************************************/
+/*!
+\file		TransformHierarchy.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Parent/child links and the depth first world transform pass, see
+            TransformHierarchy.h.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "TransformHierarchy.h"
+#include "GameObjectManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool TransformHierarchy::setParent(GameObjectManager& manager, EntityHandle child, EntityHandle parent) {
+	GameObject* childObj = manager.getGameObject(child);
+	if (!childObj) return false;
+
+	Transform* childTransform = childObj->getComponent<Transform>();
+	if (!childTransform) return false;
+
+	if (getParent(child) == parent) return true;
+
+	if (parent.isNull()) {
+		unlink(child);
+		eraseIfUnused(child);
+		m_orderDirty = true;
+		return true;
+	}
+
+	GameObject* parentObj = manager.getGameObject(parent);
+	Transform* parentTransform = parentObj ? parentObj->getComponent<Transform>() : nullptr;
+	if (!parentTransform || parent == child || isDescendant(parent, child)) return false;
+
+	unlink(child);
+	m_nodes[child].parent = parent;
+	m_nodes[parent].children.push_back(child);
+	m_orderDirty = true;
+
+	// stay where it is, the offset is whatever it is right now
+	resolveLocal(*parentTransform, *childTransform);
+	childTransform->localDirty = false;
+	childTransform->resolvedVersion = childTransform->version;
+	childTransform->parentVersion = parentTransform->version;
+	return true;
+}
+
+EntityHandle TransformHierarchy::getParent(EntityHandle child) const {
+	auto it = m_nodes.find(child);
+	return it != m_nodes.end() ? it->second.parent : EntityHandle{};
+}
+
+const std::vector<EntityHandle>& TransformHierarchy::getChildren(EntityHandle parent) const {
+	static const std::vector<EntityHandle> none;
+
+	auto it = m_nodes.find(parent);
+	return it != m_nodes.end() ? it->second.children : none;
+}
+
+bool TransformHierarchy::isDescendant(EntityHandle object, EntityHandle ancestor) const {
+	for (EntityHandle current = getParent(object); !current.isNull(); current = getParent(current)) {
+		if (current == ancestor) return true;
+	}
+	return false;
+}
+
+void TransformHierarchy::update(GameObjectManager& manager) {
+	if (m_orderDirty) rebuildOrder();
+
+	for (const Link& link : m_order) {
+		GameObject* childObj = manager.getGameObject(link.child);
+		GameObject* parentObj = manager.getGameObject(link.parent);
+		if (!childObj || !parentObj) continue;
+
+		Transform* child = childObj->getComponent<Transform>();
+		const Transform* parent = parentObj->getComponent<Transform>();
+		if (!child || !parent) continue;
+
+		// the parent came before us in the list, so it is already up to date
+		if (child->localDirty) {
+			resolveWorld(*parent, *child);
+		}
+		else if (child->version != child->resolvedVersion) {
+			resolveLocal(*parent, *child);
+		}
+		else if (parent->version != child->parentVersion) {
+			resolveWorld(*parent, *child);
+		}
+
+		child->localDirty = false;
+		child->resolvedVersion = child->version;
+		child->parentVersion = parent->version;
+	}
+}
+
+void TransformHierarchy::forget(EntityHandle handle) {
+	auto it = m_nodes.find(handle);
+	if (it == m_nodes.end()) return;
+
+	// copy, eraseIfUnused may drop nodes while we go
+	std::vector<EntityHandle> children = it->second.children;
+	for (EntityHandle child : children) {
+		m_nodes[child].parent = EntityHandle{};
+		eraseIfUnused(child);
+	}
+
+	it = m_nodes.find(handle);
+	if (it != m_nodes.end()) it->second.children.clear();
+
+	unlink(handle);
+	m_nodes.erase(handle);
+	m_orderDirty = true;
+}
+
+void TransformHierarchy::clear() {
+	m_nodes.clear();
+	m_order.clear();
+	m_orderDirty = false;
+}
+
+void TransformHierarchy::resolveWorld(const Transform& parent, Transform& child) {
+	// scale is the object's size in world units here, so it is not inherited, only the
+	// offset follows the parent's rotation and facing
+	float sign = parent.flipX ? -1.f : 1.f;
+	float angle = glm::radians(parent.rotation);
+	float c = std::cos(angle);
+	float s = std::sin(angle);
+
+	float offsetX = child.localX * sign;
+	float offsetY = child.localY;
+
+	child.x = parent.x + offsetX * c - offsetY * s;
+	child.y = parent.y + offsetX * s + offsetY * c;
+	child.rotation = parent.rotation + child.localRotation * sign;
+	child.flipX = parent.flipX != child.localFlipX;
+	child.markDirty();
+}
+
+void TransformHierarchy::resolveLocal(const Transform& parent, Transform& child) {
+	float sign = parent.flipX ? -1.f : 1.f;
+	float angle = glm::radians(parent.rotation);
+	float c = std::cos(angle);
+	float s = std::sin(angle);
+
+	float dx = child.x - parent.x;
+	float dy = child.y - parent.y;
+
+	// undo the parent's rotation, then its facing
+	child.localX = (dx * c + dy * s) * sign;
+	child.localY = -dx * s + dy * c;
+	child.localRotation = (child.rotation - parent.rotation) * sign;
+	child.localFlipX = child.flipX != parent.flipX;
+}
+
+void TransformHierarchy::rebuildOrder() {
+	m_order.clear();
+
+	std::vector<Link> stack;
+	auto pushChildren = [this, &stack](EntityHandle parent) {
+		// backwards so the first child comes off the stack first
+		const std::vector<EntityHandle>& children = getChildren(parent);
+		for (auto child = children.rbegin(); child != children.rend(); ++child) {
+			stack.push_back(Link{ *child, parent });
+		}
+	};
+
+	for (const auto& [handle, node] : m_nodes) {
+		// start from the top of every tree
+		if (!node.parent.isNull()) continue;
+
+		pushChildren(handle);
+		while (!stack.empty()) {
+			Link link = stack.back();
+			stack.pop_back();
+
+			m_order.push_back(link);
+			pushChildren(link.child);
+		}
+	}
+
+	m_orderDirty = false;
+}
+
+void TransformHierarchy::unlink(EntityHandle child) {
+	auto it = m_nodes.find(child);
+	if (it == m_nodes.end() || it->second.parent.isNull()) return;
+
+	EntityHandle parent = it->second.parent;
+	it->second.parent = EntityHandle{};
+
+	auto parentIt = m_nodes.find(parent);
+	if (parentIt != m_nodes.end()) {
+		std::vector<EntityHandle>& siblings = parentIt->second.children;
+		siblings.erase(std::remove(siblings.begin(), siblings.end(), child), siblings.end());
+	}
+	eraseIfUnused(parent);
+}
+
+void TransformHierarchy::eraseIfUnused(EntityHandle handle) {
+	auto it = m_nodes.find(handle);
+	if (it != m_nodes.end() && it->second.parent.isNull() && it->second.children.empty()) {
+		m_nodes.erase(it);
+	}
+}
@@ -0,0 +1,166 @@
+/* Start Header ************************************************************************/
+/*!
+\file		World.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 16th, 2026
+\brief      The simulation part of the frame and the fixed step graph, for one World.
+            See World.h.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "World.h"
+#include "JsonIO.h"
+
+#include <algorithm>
+#include <filesystem>
+
+World::World(double fixedDt, bool ownsInput)
+    : m_fixedDt(fixedDt),
+    m_ownsInput(ownsInput)
+{
+    m_luaSystem.init();
+
+    m_messageBus.subscribe("KeyPressed", &m_playerController);
+    m_messageBus.subscribe("KeyReleased", &m_playerController);
+
+    registerSystems();
+}
+
+World::~World() {
+    m_luaSystem.cleanup();
+}
+
+bool World::load(const std::string& scene) {
+    std::string path = std::filesystem::exists(scene) ? scene : JsonIO::runtimeScenePath(scene);
+    m_manager.loadScene(path);
+    if (m_manager.getGameObjectCount() == 0) {
+        std::cerr << "[World] Nothing loaded from " << path << "\n";
+        return false;
+    }
+
+    m_luaSystem.attachScripts(m_manager);
+    return true;
+}
+
+void World::update(float deltaTime, int simSteps) {
+    setFrameSteps(simSteps);
+    m_frameScheduler.run(deltaTime);
+}
+
+/**
+ * @brief Builds the step graph and the World's own frame graph.
+ *
+ * Physics -> Collision -> Logic run at the fixed rate, simSteps times an update.
+ * Lua and the hierarchy run once an update with the frame delta. Each system lists
+ * what it reads and writes, see SystemScheduler. The frame graph is the same one
+ * CoreEngine puts in its own graph (registerSimulation/registerSimulationEnd), plus
+ * the sync point CoreEngine has of its own.
+ */
+void World::registerSystems() {
+    m_stepSystems = {
+        //where everything was before this step, Render interpolates from here
+        { "Interpolation", SystemAccess().write<Transform>(), SystemThread::Any,
+            [this](float) {
+                m_manager.each<Transform>([](GameObject&, Transform& transform) { transform.snapshotInterpolation(); });
+            }, true },
+
+        { "Physics",
+            SystemAccess().read<Input>().write<Transform, Physics, Render>().read(EngineResource::StepInput)
+                .read(EngineResource::EditorState).write(EngineResource::MessageBus).write(EngineResource::CommandBuffer)
+                .write(EngineResource::ObjectPools),
+            SystemThread::Any, [this](float dt) { m_physicsSystem.update(m_manager, dt, m_messageBus); }, true },
+
+        { "Collision",
+            SystemAccess().read<Render>().write<Transform, Physics, CollisionInfo>(),
+            SystemThread::Any, [this](float dt) { m_collisionSystem.update(m_manager, dt); }, true },
+
+        { "Logic",
+            SystemAccess().read<Transform>().write<StateMachine, Physics, Animation, AudioComponent>()
+                .read(EngineResource::StepInput).write(EngineResource::CommandBuffer),
+            SystemThread::Any, [this](float dt) { m_logicSystem.update(m_manager, dt); }, true },
+
+        //children follow whatever physics/logic did to their parents this step. after the
+        //last step the frame's hierarchy pass does it
+        { "Hierarchy",
+            SystemAccess().write<Transform>().write(EngineResource::Hierarchy),
+            SystemThread::Any, [this](float) { m_manager.getHierarchy().update(m_manager); }, false },
+
+        //sync point: bullets fired this step start moving in the next one. after the last
+        //step it is the owner's next sync point
+        { "Commands", SystemAccess().writeAll(),
+            SystemThread::Main, [this](float) { m_manager.playbackCommands(); }, false },
+    };
+
+    for (const StepSystem& system : m_stepSystems) {
+        m_stepScheduler.addSystem(system.name, system.access, system.thread, system.fn);
+    }
+
+    registerSimulation(m_frameScheduler);
+    registerSimulationEnd(m_frameScheduler);
+    m_frameScheduler.addSystem("Commands", SystemAccess().writeAll(),
+        SystemThread::Main, [this](float) { m_manager.playbackCommands(); });
+}
+
+void World::registerSimulation(SystemScheduler& scheduler) {
+    scheduler.addSystem("Lua",
+        SystemAccess().read<LuaScript>().write<Transform, Render, Physics>()
+            .read(EngineResource::EditorState).write(EngineResource::MessageBus).write(EngineResource::ObjectPools)
+            .write(EngineResource::Hierarchy),
+        SystemThread::Main, [this](float dt) {
+            if (!EditorManager::isEditingMode() && !EditorManager::isPaused()) m_luaSystem.update(m_manager, dt);
+        });
+
+    //sync point: apply what the menus/scripts queued before the simulation runs
+    scheduler.addSystem("Commands", SystemAccess().writeAll(),
+        SystemThread::Main, [this](float) { m_manager.playbackCommands(); });
+
+    //the steps a slow frame has to catch up on, each a run of the step graph. it touches
+    //everything and ends in a sync point, so it is one barrier, but only busy when behind
+    scheduler.addSystem("Simulation", SystemAccess().writeAll(),
+        SystemThread::Main, [this](float) { runSteps(std::max(0, m_frameSteps - 1)); });
+
+    //the last step's systems go straight into the caller's graph with their own access, so
+    //whatever only reads their results can run next to the rest of the step
+    const float fixedDt = static_cast<float>(m_fixedDt);
+    for (const StepSystem& system : m_stepSystems) {
+        if (!system.inLastStep) continue;
+        scheduler.addSystem(system.name, system.access, system.thread, [this, fixedDt, fn = system.fn](float) {
+            if (m_frameSteps > 0) fn(fixedDt);
+        });
+    }
+
+    //the last step is over once nothing reads its key state any more
+    scheduler.addSystem("StepEnd", SystemAccess().write(EngineResource::StepInput),
+        SystemThread::Any, [this](float) {
+            if (m_frameSteps > 0) finishStep();
+        });
+}
+
+void World::registerSimulationEnd(SystemScheduler& scheduler) {
+    //the last step's children, and again outside the steps for Lua and the editor moving
+    //things while nothing simulates
+    scheduler.addSystem("Hierarchy",
+        SystemAccess().write<Transform>().write(EngineResource::Hierarchy),
+        SystemThread::Any, [this](float) { m_manager.getHierarchy().update(m_manager); });
+}
+
+void World::runSteps(int simSteps) {
+    const float fixedDt = static_cast<float>(m_fixedDt);
+    for (int step = 0; step < simSteps; ++step) {
+        m_stepScheduler.run(fixedDt);
+        finishStep();
+    }
+}
+
+void World::finishStep() {
+    ++m_stepCount;
+
+    //presses seen by this step are not seen again by the next
+    if (m_ownsInput) InputHandler::endSimulationStep();
+}
@@ -97,7 +97,7 @@ void AudioHandler::update(float deltaTime) {
 	//}
 	auto end = std::chrono::high_resolution_clock::now();
 	double ms = std::chrono::duration<double, std::milli>(end - start).count(); //get elapse time in ms
-	g_SystemTimers.push_back({ "Audio", ms }); //saving timing for UI output
+	PushSystemTimer("Audio", ms); //saving timing for UI output
 }
 
 // release all sounds and shut down the audio system (will shutdown automatically when dtor called)
@@ -186,14 +186,8 @@ FMOD::Channel* AudioHandler::playSound(AudioChannel* audio) {
 }
 
 void AudioHandler::pauseAll(GameObjectManager& manager) {
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-
-	for (GameObject* obj : gameObjects) {
-		if (!obj->hasComponent<AudioComponent>()) continue;
-		AudioComponent* ac = obj->getComponent<AudioComponent>();
-
-		for (auto& pair : ac->audioChannels) {
+	manager.each<AudioComponent>([this](GameObject&, AudioComponent& ac) {
+		for (auto& pair : ac.audioChannels) {
 
 			AudioChannel& ch = pair.second;
 
@@ -203,19 +197,12 @@ void AudioHandler::pauseAll(GameObjectManager& manager) {
 			}
 
 		}
-
-	}
+	});
 }
 
 void AudioHandler::resumeAll(GameObjectManager& manager) {
-	std::vector<GameObject*> gameObjects;
-	manager.getAllGameObjects(gameObjects);
-
-	for (GameObject* obj : gameObjects) {
-		if (!obj->hasComponent<AudioComponent>()) continue;
-		AudioComponent* ac = obj->getComponent<AudioComponent>();
-
-		for (auto& pair : ac->audioChannels) {
+	manager.each<AudioComponent>([this](GameObject&, AudioComponent& ac) {
+		for (auto& pair : ac.audioChannels) {
 
 			AudioChannel& ch = pair.second;
 
@@ -225,8 +212,7 @@ void AudioHandler::resumeAll(GameObjectManager& manager) {
 			}
 
 		}
-
-	}
+	});
 }
 
 // PAUSE / RESUME a particular sound
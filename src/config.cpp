@@ -47,9 +47,18 @@ namespace {
         debug.AddMember("show_fps_in_title", src.show_fps_in_title, a);
         debug.AddMember("show_input_debug", src.show_input_debug, a);
 
+        rapidjson::Value jobs(rapidjson::kObjectType);
+        jobs.AddMember("worker_threads", src.worker_threads, a);
+
+        rapidjson::Value simulation(rapidjson::kObjectType);
+        simulation.AddMember("fixed_hz", src.fixed_hz, a);
+        simulation.AddMember("max_steps", src.max_steps, a);
+
         doc.AddMember("window", window, a);
         doc.AddMember("render", render, a);
         doc.AddMember("debug", debug, a);
+        doc.AddMember("jobs", jobs, a);
+        doc.AddMember("simulation", simulation, a);
     }
 }
 
@@ -80,6 +89,17 @@ bool LoadConfig(const std::string& path, AppConfig& out, std::string* err)
         applyBool(d, "show_input_debug", out.show_input_debug);
     }
 
+    if (doc.HasMember("jobs") && doc["jobs"].IsObject()) {
+        const auto& j = doc["jobs"];
+        applyInt(j, "worker_threads", out.worker_threads);
+    }
+
+    if (doc.HasMember("simulation") && doc["simulation"].IsObject()) {
+        const auto& s = doc["simulation"];
+        applyInt(s, "fixed_hz", out.fixed_hz);
+        applyInt(s, "max_steps", out.max_steps);
+    }
+
     gShowFpsInTitle = out.show_fps_in_title;
     gShowInputDebug = out.show_input_debug;
     for (int i = 0; i < 4; ++i)
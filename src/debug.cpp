@@ -15,6 +15,7 @@ Technology is prohibited.
 
 #include "debug.h"
 #include "JsonIO.h"
+#include <cmath>
 // ======================================================================================
 // Internal helpers (anonymous namespace): thread-safe file append + time formatting
 // ======================================================================================
@@ -224,6 +225,12 @@ namespace Perf {
             ++steps;
         }
 
+        // Hit the step cap: drop the backlog instead of carrying it into the next
+        // frames, otherwise a long stall (pause, breakpoint) keeps us at max steps
+        if (accumulator >= fixed_dt) {
+            accumulator = std::fmod(accumulator, fixed_dt);
+        }
+
         steps_out = steps;
         alpha_out = accumulator / fixed_dt; // for render interpolation (0..1)
     }
@@ -14,6 +14,8 @@ Technology is prohibited.
 */
 /* End Header **************************************************************************/
 
+#include <cstddef>
+
 //std::vector<FT_Face> Font::face;
 //FT_Library Font::ft;
 //int Font::fontTypes = 3;
@@ -60,16 +62,24 @@ int Font::init()
 
 Font::FontMdl Font::fontMeshInit()
 {
+    // no vertex data, only instances: FontSystem refills vbo every frame
     FontMdl mdl;
-    glGenVertexArrays(1, &mdl.vao);
-    glGenBuffers(1, &mdl.vbo);
-    glBindVertexArray(mdl.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, mdl.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    glCreateVertexArrays(1, &mdl.vao);
+    glCreateBuffers(1, &mdl.vbo);
+    glVertexArrayVertexBuffer(mdl.vao, 0, mdl.vbo, 0, sizeof(GlyphInstance));
+    glVertexArrayBindingDivisor(mdl.vao, 0, 1);
+
+    glEnableVertexArrayAttrib(mdl.vao, 0);
+    glVertexArrayAttribFormat(mdl.vao, 0, 4, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(GlyphInstance, rect)));
+    glVertexArrayAttribBinding(mdl.vao, 0, 0);
+
+    glEnableVertexArrayAttrib(mdl.vao, 1);
+    glVertexArrayAttribFormat(mdl.vao, 1, 4, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(GlyphInstance, uv)));
+    glVertexArrayAttribBinding(mdl.vao, 1, 0);
+
+    glEnableVertexArrayAttrib(mdl.vao, 2);
+    glVertexArrayAttribFormat(mdl.vao, 2, 4, GL_UNSIGNED_BYTE, GL_TRUE, static_cast<GLuint>(offsetof(GlyphInstance, color)));
+    glVertexArrayAttribBinding(mdl.vao, 2, 0);
     return mdl;
 }
 
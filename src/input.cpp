@@ -25,6 +25,7 @@ AppConfig InputHandler::m_cfg;
 
 bool InputHandler::m_keys[1024] = { false };
 bool InputHandler::m_keysPrevious[1024] = { false };
+bool InputHandler::m_keysPreviousStep[1024] = { false };
 
 bool InputHandler::m_mouseButtons[8] = { false };
 bool InputHandler::m_mouseButtonsPrevious[8] = { false };
@@ -42,6 +43,7 @@ double InputHandler::m_doubleClickThreshold = 0.25;
 void InputHandler::init(GLFWwindow* window, const AppConfig& cfg) {
 	m_window = window;
 	m_cfg = cfg;
+	if (!window) return;
 
 	// set up the callbacks
 	glfwSetKeyCallback(window, keyCallback);
@@ -64,7 +66,7 @@ void InputHandler::update() {
 	// reset scroll each frame
 	m_scrollOffset = 0.0f;
 
-	glfwPollEvents();
+	if (m_window) glfwPollEvents();
 }
 
 
@@ -77,6 +79,32 @@ bool InputHandler::isKeyTriggered(int key) {
 	return (m_keys[key] && !m_keysPrevious[key]);
 }
 
+// check if key is triggered since the last simulation step
+bool InputHandler::isKeyTriggeredThisStep(int key) {
+	if (key < 0 || key >= 1024) return false;
+
+	return (m_keys[key] && !m_keysPreviousStep[key]);
+}
+
+void InputHandler::endSimulationStep() {
+	memcpy(m_keysPreviousStep, m_keys, sizeof(m_keys));
+}
+
+void InputHandler::captureFrame(FrameInput& out) {
+	memcpy(out.keys, m_keys, sizeof(m_keys));
+	memcpy(out.mouseButtons, m_mouseButtons, sizeof(m_mouseButtons));
+	out.mousePosition = m_mousePosition;
+	out.scroll = m_scrollOffset;
+}
+
+void InputHandler::applyFrame(const FrameInput& in) {
+	// the previous frame's state was replaced the same way, so triggered/released still work
+	memcpy(m_keys, in.keys, sizeof(m_keys));
+	memcpy(m_mouseButtons, in.mouseButtons, sizeof(m_mouseButtons));
+	m_mousePosition = in.mousePosition;
+	m_scrollOffset = in.scroll;
+}
+
 // check if key is released (released this frame)
 bool InputHandler::isKeyReleased(int key) {
 	if (key < 0 || key >= 1024) return false;
@@ -0,0 +1,88 @@
+/* Start Header ************************************************************************/
+/*!
+\file		jobBenchmark.cpp
+\author     Hugo Low Ren Hao, low.h, 2402272
+\par        low.h@digipen.edu
+\date		October, 15th, 2026
+\brief      Micro benchmark for the job system, see jobBenchmark.h.
+
+Copyright (C) 2025 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents
+without the prior written consent of DigiPen Institute of
+Technology is prohibited.
+*/
+/* End Header **************************************************************************/
+
+#include "jobBenchmark.h"
+#include "Systems.h"
+#include "JobSystem.h"
+#include "ResourceManager.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+int RunJobBenchmark(int spriteCount, int frames)
+{
+	// nothing is loaded or drawn, so make up 8 texture ids in 4 arrays of 2 layers. sprites
+	// are batched by array, the same as if those were 4 image sizes
+	const GLuint fakeTextures = 8;
+	ResourceManager& resources = ResourceManager::getInstance();
+	for (GLuint texture = 1; texture <= fakeTextures; ++texture) {
+		resources.setTextureLayer(texture, TextureLayer{ 1 + (texture - 1) / 2, (texture - 1) % 2 });
+	}
+
+	GameObjectManager manager;
+	for (int i = 0; i < spriteCount; ++i)
+	{
+		GameObject* object = manager.createGameObject("bench_" + std::to_string(i));
+		Transform* transform = object->addComponent<Transform>();
+		transform->x = static_cast<float>(i % 256) * 8.f;
+		transform->y = static_cast<float>(i / 256) * 8.f;
+		transform->rotation = static_cast<float>(i % 360);
+
+		Render* render = object->addComponent<Render>();
+		render->hasTex = (i % 2) == 0;
+		render->texHDL = 1 + static_cast<GLuint>(i / 2) % fakeTextures; // every made up id above
+	}
+
+	// batchingSetUp only builds the instance arrays, it does not touch GL
+	RenderSystem renderSystem;
+	const float deltaTime = 1.f / 60.f;
+
+	// a view over the whole field, every sprite is batched as before culling
+	const float rows = static_cast<float>(spriteCount / 256 + 1);
+	const SpatialGrid::Rect everything{ -8.f, -8.f, 256.f * 8.f + 8.f, rows * 8.f + 8.f };
+
+	unsigned maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) maxThreads = 1;
+
+	std::cout << "[JobBenchmark] " << spriteCount << " sprites, " << frames << " frames per run\n";
+
+	double singleThreadMs = 0.0;
+	for (unsigned threads = 1; threads <= maxThreads; ++threads)
+	{
+		JobSystem::getInstance().init(static_cast<int>(threads) - 1);
+
+		// warm up, sizes the scratch buffers and the per batch vectors
+		renderSystem.batchingSetUp(manager, deltaTime, everything);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			renderSystem.batchingSetUp(manager, deltaTime, everything);
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		double ms = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+		if (threads == 1) singleThreadMs = ms;
+
+		std::cout << "[JobBenchmark] threads " << std::setw(2) << threads
+			<< "  " << std::fixed << std::setprecision(3) << ms << " ms/frame"
+			<< "  x" << std::setprecision(2) << (ms > 0.0 ? singleThreadMs / ms : 0.0) << "\n";
+	}
+
+	JobSystem::getInstance().shutdown();
+	for (GLuint texture = 1; texture <= fakeTextures; ++texture) resources.setTextureLayer(texture, TextureLayer{});
+	return 0;
+}
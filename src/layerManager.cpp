@@ -117,13 +117,17 @@ int LayerManager::getObjectLayer(GameObject* obj) const {
 
 std::vector<Layer*> LayerManager::getAllLayers() const {
 	std::vector<Layer*> layers;
+	getAllLayers(layers);
+	return layers;
+}
+
+void LayerManager::getAllLayers(std::vector<Layer*>& layers) const {
+	layers.clear();
 	layers.reserve(m_layers.size());
 
 	for(const auto& layer : m_layers) {
 		layers.push_back(layer.second.get());
 	}
-
-	return layers;
 }
 
 void LayerManager::clearAllLayers() {
@@ -20,13 +20,31 @@ void LuaSystem::init() {
     L = luaL_newstate();
     luaL_openlibs(L);
     lua_register(L, "Input_isKeyHeld", Lua_IsKeyHeld);
-    lua_register(L, "getPosition", Lua_getPosition);
-    lua_register(L, "setPosition", Lua_setPosition);
+
+    //object functions need the manager to turn handles back into objects
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, Lua_getPosition, 1);
+    lua_setglobal(L, "getPosition");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, Lua_setPosition, 1);
+    lua_setglobal(L, "setPosition");
 
     //for message
     lua_pushlightuserdata(L, this);
     lua_pushcclosure(L, Lua_SendInputEvent, 1);
     lua_setglobal(L, "SendInputEvent");
+
+    //prefab pools
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, Lua_PoolAcquire, 1);
+    lua_setglobal(L, "Pool_acquire");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, Lua_PoolRelease, 1);
+    lua_setglobal(L, "Pool_release");
+    //hierarchy
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, Lua_setParent, 1);
+    lua_setglobal(L, "setParent");
     //manager = std::make_unique<GameObjectManager>();
 }
 
@@ -82,9 +100,18 @@ float LuaSystem::getGlobalNumber(const std::string& name) {
     return val;
 }
 
+//scripts only ever see an integer handle, so an object deleted mid-script resolves to nullptr
+GameObject* LuaSystem::getObjectArg(lua_State* L, int index) {
+    LuaSystem* self = static_cast<LuaSystem*>(lua_touserdata(L, lua_upvalueindex(1)));
+    if (!self || !self->gameObjectManager || !lua_isinteger(L, index)) return nullptr;
+
+    EntityHandle handle = EntityHandle::fromBits(static_cast<std::uint64_t>(lua_tointeger(L, index)));
+    return self->gameObjectManager->getGameObject(handle);
+}
+
 //get position of object from Lua
 int LuaSystem::Lua_getPosition(lua_State* L) {
-    GameObject* obj = static_cast<GameObject*>(lua_touserdata(L, 1));
+    GameObject* obj = getObjectArg(L, 1);
     if (!obj) return 0;
 
     //get the object Transform component
@@ -100,7 +127,7 @@ int LuaSystem::Lua_getPosition(lua_State* L) {
 
 //set position of object from Lua
 int LuaSystem::Lua_setPosition(lua_State* L) {
-    GameObject* obj = static_cast<GameObject*>(lua_touserdata(L, 1));
+    GameObject* obj = getObjectArg(L, 1);
     if (!obj)
         return 0;
 
@@ -115,6 +142,7 @@ int LuaSystem::Lua_setPosition(lua_State* L) {
     transform->x = x;
     transform->y = y;
     //transform->z = z; //idk if needed cause in the transform i see there is z
+    transform->markDirty();
 
     return 0;
 }
@@ -122,8 +150,7 @@ int LuaSystem::Lua_setPosition(lua_State* L) {
 bool LuaSystem::loadScriptForObject(const std::string& filename, const std::string& tableName) {
     if (!L) return false;
 
-    //reload only if file modified
-    static std::unordered_map<std::string, std::filesystem::file_time_type> fileTimes;
+    //reload only if file modified. per Lua state, every World has its own and needs the script loaded into it
     auto currentTime = std::filesystem::last_write_time(filename);
     bool reload = false;
 
@@ -171,7 +198,7 @@ bool LuaSystem::updateObjectScript(const std::string& tableName, GameObject* obj
         return false;
     }
 
-    lua_pushlightuserdata(L, obj);
+    lua_pushinteger(L, static_cast<lua_Integer>(obj->getHandle().toBits()));
     lua_pushnumber(L, deltaTime);
 
     //call the Update function with 2 arguments and 0 return values
@@ -204,15 +231,84 @@ int LuaSystem::Lua_SendInputEvent(lua_State* L) {
     return 0;
 }
 
+//Pool_acquire("bullet") -> handle of a free pooled object, nil if the pool is empty or missing
+int LuaSystem::Lua_PoolAcquire(lua_State* L) {
+    LuaSystem* self = static_cast<LuaSystem*>(lua_touserdata(L, lua_upvalueindex(1)));
+    const char* prefabName = lua_tostring(L, 1);
+    if (!self || !self->gameObjectManager || !prefabName) return 0;
+
+    GameObjectManager& manager = *self->gameObjectManager;
+    ObjectPool& pool = manager.getPrefabPool();
+    GameObject* obj = pool.acquire(manager, pool.findPrefabID(prefabName));
+    if (!obj) return 0;
+
+    lua_pushinteger(L, static_cast<lua_Integer>(obj->getHandle().toBits()));
+    return 1;
+}
+
+//Pool_release(handle) -> true if the object went back to its pool
+int LuaSystem::Lua_PoolRelease(lua_State* L) {
+    LuaSystem* self = static_cast<LuaSystem*>(lua_touserdata(L, lua_upvalueindex(1)));
+    if (!self || !self->gameObjectManager || !lua_isinteger(L, 1)) return 0;
+
+    EntityHandle handle = EntityHandle::fromBits(static_cast<std::uint64_t>(lua_tointeger(L, 1)));
+    lua_pushboolean(L, self->gameObjectManager->getPrefabPool().release(*self->gameObjectManager, handle));
+    return 1;
+}
+
+//setParent(child, parent) attaches child where it is now, setParent(child, nil) detaches it
+int LuaSystem::Lua_setParent(lua_State* L) {
+    LuaSystem* self = static_cast<LuaSystem*>(lua_touserdata(L, lua_upvalueindex(1)));
+    GameObject* child = getObjectArg(L, 1);
+    if (!self || !child) return 0;
+
+    EntityHandle parent;
+    if (!lua_isnoneornil(L, 2)) {
+        GameObject* parentObj = getObjectArg(L, 2);
+        if (!parentObj) return 0;
+        parent = parentObj->getHandle();
+    }
+
+    GameObjectManager& manager = *self->gameObjectManager;
+    lua_pushboolean(L, manager.getHierarchy().setParent(manager, child->getHandle(), parent));
+    return 1;
+}
+
+//<name>.lua in folder goes to the object called <name>, objects without a script are left alone
+void LuaSystem::attachScripts(GameObjectManager& manager, const std::string& folder) {
+    //iterate over all Lua scripts in the folder
+    for (const auto& file : std::filesystem::directory_iterator(folder)) {
+        if (file.path().extension() != ".lua") continue; //have to be .lua files if not it will skip
+        std::string filename = file.path().filename().string();
+
+        //strip ".lua" to get object name
+        std::string objectName = filename.substr(0, filename.size() - 4);
+
+        GameObject* obj = manager.getGameObject(objectName);
+        if (obj) {
+            obj->addComponent<LuaScript>(file.path().string()); //add LuaScript component to object
+            //load Lua script into Lua state
+            if (!loadScriptForObject(file.path().string(), objectName)) {
+                std::cerr << "[Lua] Failed to load script for " << objectName << std::endl;
+            }
+            else {
+                std::cout << "[Lua] Loaded script " << filename << " for object " << objectName << std::endl;
+            }
+        }
+    }
+}
+
 //lua updates for all objects with LuaScript component
 void LuaSystem::update(GameObjectManager& manager, float deltaTime) {
+    gameObjectManager = &manager;
+
+    // snapshot, scripts are free to add components or spawn objects
     std::vector<GameObject*> gameObjects;
-    manager.getAllGameObjects(gameObjects);
+    manager.view<LuaScript>().collect(gameObjects);
 
     for (GameObject* obj : gameObjects) {
-        if (obj->hasComponent<LuaScript>()) {
-            LuaScript* scriptComp = obj->getComponent<LuaScript>();
-            updateObjectScript(scriptComp->scriptName, obj, deltaTime);
-        }
+        // copy the name, the script may move this object's components
+        std::string scriptName = obj->getComponent<LuaScript>()->scriptName;
+        updateObjectScript(scriptName, obj, deltaTime);
     }
 }
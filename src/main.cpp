@@ -16,6 +16,10 @@ Technology is prohibited.
 /* End Header **************************************************************************/
 
 #include "CoreEngine.h"
+#include "jobBenchmark.h"
+
+#include <algorithm>
+#include <cstdlib>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -37,17 +41,97 @@ int main(int argc, char** argv){
     CrashLog::Init("crash_log.txt");
 
     bool forceWindowed = false;
+    bool benchJobs = false;
+    bool headless = false;
+    std::string headlessScene = "level01.json";
+    int headlessFrames = 3600; // one simulated minute at 60 Hz
+    std::string recordPath;
+    std::string replayPath;
+    int worlds = 1;
     for (int i = 1; i < argc; ++i)
     {
         if (std::string(argv[i]) == "--windowed")
         {
             forceWindowed = true;
         }
+        else if (std::string(argv[i]) == "--bench-jobs")
+        {
+            benchJobs = true;
+        }
+        // --headless [--scene level01.json] [--frames 3600]: simulation only, no window
+        else if (std::string(argv[i]) == "--headless")
+        {
+            headless = true;
+        }
+        else if (std::string(argv[i]) == "--scene" && i + 1 < argc)
+        {
+            headlessScene = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--frames" && i + 1 < argc)
+        {
+            headlessFrames = std::max(std::atoi(argv[++i]), 0);
+        }
+        // --record session.rply / --replay session.rply, works with and without --headless
+        else if (std::string(argv[i]) == "--record" && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--replay" && i + 1 < argc)
+        {
+            replayPath = argv[++i];
+        }
+        // --worlds 32: that many independent copies of the scene, stepped in parallel (implies --headless)
+        else if (std::string(argv[i]) == "--worlds" && i + 1 < argc)
+        {
+            worlds = std::max(std::atoi(argv[++i]), 1);
+            headless = true;
+        }
+    }
+
+    // job system micro benchmark, runs without a window and exits
+    if (benchJobs)
+    {
+        int result = RunJobBenchmark();
+        CrashLog::Shutdown();
+        return result;
     }
 
     // Create the engine using a smart pointer for automatic cleanup
     auto engine = std::make_unique<CoreEngine>();
 
+    // there is one keyboard to record or replay, so that stays with a single world
+    if (worlds > 1 && (!recordPath.empty() || !replayPath.empty()))
+    {
+        std::cout << "--worlds ignored, recording and replay run a single world\n";
+        worlds = 1;
+    }
+
+    if (!recordPath.empty()) engine->RecordTo(recordPath);
+    if (!replayPath.empty() && !engine->ReplayFrom(replayPath))
+    {
+        CrashLog::Shutdown();
+        return -1;
+    }
+
+    // automated playtests/balancing on machines without a display
+    if (headless)
+    {
+        int result = 0;
+        try {
+            engine->InitHeadless(headlessScene, worlds);
+            result = engine->RunHeadless(headlessFrames);
+        }
+        catch (const std::exception& e) {
+            CrashLog::WriteException(e.what());
+            std::cerr << "Unhandled exception: " << e.what() << std::endl;
+            result = -1;
+        }
+
+        engine->Shutdown();
+        CrashLog::Shutdown();
+        return result;
+    }
+
     try {
         engine->Init(forceWindowed);
         engine->Run();
@@ -17,7 +17,101 @@ Technology is prohibited.
 
 #include "performance.h"
 
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+#include <new>
+
 std::vector<SystemTimer> g_SystemTimers;
+AllocationStats g_FrameAllocations;
+
+namespace {
+	std::mutex s_timerMutex;
+
+	std::atomic<size_t> s_allocations{ 0 };
+	std::atomic<size_t> s_frees{ 0 };
+	std::atomic<size_t> s_bytes{ 0 };
+}
+
+void PushSystemTimer(const std::string& name, double ms) {
+	std::lock_guard<std::mutex> lock(s_timerMutex);
+	g_SystemTimers.push_back({ name, ms });
+}
+
+AllocationStats GetAllocationTotals() {
+	AllocationStats totals;
+	totals.allocations = s_allocations.load(std::memory_order_relaxed);
+	totals.frees = s_frees.load(std::memory_order_relaxed);
+	totals.bytes = s_bytes.load(std::memory_order_relaxed);
+	return totals;
+}
+
+void MarkAllocationFrame() {
+	static AllocationStats previous;
+	AllocationStats current = GetAllocationTotals();
+
+	g_FrameAllocations.allocations = current.allocations - previous.allocations;
+	g_FrameAllocations.frees = current.frees - previous.frees;
+	g_FrameAllocations.bytes = current.bytes - previous.bytes;
+	previous = current;
+}
+
+/* ---- counting global new/delete, so the performance window and the console reports can show
+   heap traffic per frame. in every build, release is the one the steady state has to hold in ---- */
+namespace {
+	void* countedAlloc(size_t size) {
+		s_allocations.fetch_add(1, std::memory_order_relaxed);
+		s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+		void* ptr = std::malloc(size ? size : 1);
+		if (!ptr) throw std::bad_alloc();
+		return ptr;
+	}
+
+	void* countedAlignedAlloc(size_t size, std::align_val_t alignment) {
+		s_allocations.fetch_add(1, std::memory_order_relaxed);
+		s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+		size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+		void* ptr = _aligned_malloc(size ? size : 1, align);
+#else
+		void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+		if (!ptr) throw std::bad_alloc();
+		return ptr;
+	}
+
+	void countedFree(void* ptr) {
+		if (!ptr) return;
+		s_frees.fetch_add(1, std::memory_order_relaxed);
+		std::free(ptr);
+	}
+
+	void countedAlignedFree(void* ptr) {
+		if (!ptr) return;
+		s_frees.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+}
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
 
 void LogSystemTimersEveryInterval(float deltaTime, double intervalSeconds){
     static double accumulator = 0.0;
@@ -35,6 +129,8 @@ void LogSystemTimersEveryInterval(float deltaTime, double intervalSeconds){
             float percent = totalMs > 0.0 ? (float)((timer.ms / totalMs) * 100.0) : 0.0f;
             std::cout << timer.name << ": " << timer.ms << " ms (" << percent << "%)" << std::endl;
         }
+        std::cout << "Heap: " << g_FrameAllocations.allocations << " allocations, "
+            << g_FrameAllocations.frees << " frees last frame" << std::endl;
         std::cout << "=================================\n" << std::endl;
     }
     g_SystemTimers.clear();
@@ -59,6 +59,7 @@ void PhysicsForces::updatePosition(Transform* transform, Physics* physics, float
     }
     transform->x = physics->dynamics.position.x;
     transform->y = physics->dynamics.position.y;
+    transform->markDirty();
 
    
     physics->velX = physics->dynamics.velocity.x;
@@ -71,7 +72,7 @@ void PhysicsForces::updatePosition(Transform* transform, Physics* physics, float
  * Applies an upward force to the object's dynamics system 
  */
 void PhysicsForces::jump(GameObject* object) {
-    if (!object->hasComponent<Physics>() || !object->hasComponent<Transform>())
+    if (!object->hasComponents<Physics, Transform>())
         return;
 
     Physics* physics = object->getComponent<Physics>();
@@ -92,7 +93,7 @@ void PhysicsForces::jump(GameObject* object) {
  * and configures bullet properties for horizontal movement
  */
 void PhysicsForces::shoot(GameObject* bullet, const Transform* origin) {
-    if (!bullet->hasComponent<Physics>() || !bullet->hasComponent<Transform>())
+    if (!bullet->hasComponents<Physics, Transform>())
         return;
 
     Transform* t = bullet->getComponent<Transform>();
@@ -102,6 +103,8 @@ void PhysicsForces::shoot(GameObject* bullet, const Transform* origin) {
     t->x = origin->x;
     t->y = origin->y;
     t->z = 0.0f;
+    t->markDirty();
+    t->resetInterpolation();
     //t->scaleX = 0.5f;
     //t->scaleY = 0.5f;
     //t->scaleZ = 0.5f;
@@ -131,50 +134,15 @@ void PhysicsForces::shoot(GameObject* bullet, const Transform* origin) {
 }
 
 /**
- * @brief Finds an available bullet from the object pool
+ * @brief Takes a free bullet from the object pool
  *
- * Searches through all game objects to find inactive bullets
- * following the naming pattern "bullet" followed by numbers.
+ * The scene's "pools" array decides how many bullets exist, the pool is found
+ * through the bullet prefab's name so no prefab ID is hardcoded here.
  */
-GameObject* PhysicsForces::findAvailableBullet(GameObjectManager& manager) { 
+GameObject* PhysicsForces::acquireBullet(GameObjectManager& manager) { 
 
-    std::vector<GameObject*> gameObjects;
-    manager.getAllGameObjects(gameObjects);
-
-    for (GameObject* obj : gameObjects) {
-        std::string name = obj->getObjectName();
-
-
-        if (name.find("bullet") == 0) {
-
-            bool isNumberedBullet = true;
-            if (name.length() > 6) {
-                for (size_t i = 6; i < name.length(); i++) {
-                    if (!std::isdigit(name[i])) {
-                        isNumberedBullet = false;
-                        break;
-                    }
-                }
-            }
-            else {
-                isNumberedBullet = false;
-            }
-
-            if (isNumberedBullet) {
-                if (!obj->hasComponent<Physics>() || !obj->hasComponent<Transform>())
-                    continue;
-
-                Physics* p = obj->getComponent<Physics>();
-
-
-                if (!p->alive) {
-                    return obj;
-                }
-            }
-        }
-    }
-
-    return nullptr;
+    ObjectPool& pool = manager.getPrefabPool();
+    return pool.acquire(manager, pool.findPrefabID("bullet"));
 }
 /**
  * @brief Deactivates a bullet and resets it for object pooling
@@ -184,7 +152,7 @@ GameObject* PhysicsForces::findAvailableBullet(GameObjectManager& manager) {
  */
 void PhysicsForces::deactivateBullet(GameObject* bullet) { 
 
-    if (!bullet || !bullet->hasComponent<Physics>() || !bullet->hasComponent<Transform>())
+    if (!bullet || !bullet->hasComponents<Physics, Transform>())
         return;
 
     Physics* p = bullet->getComponent<Physics>();
@@ -200,6 +168,8 @@ void PhysicsForces::deactivateBullet(GameObject* bullet) {
     // Reset to original state instead of hardcoded values
     t->x = p->originalPos.x;
     t->y = p->originalPos.y;
+    t->markDirty();
+    t->resetInterpolation();
 
     p->dynamics.position.x = p->originalPos.x;
     p->dynamics.position.y = p->originalPos.y;
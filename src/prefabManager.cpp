@@ -663,6 +663,7 @@ void PrefabManager::applyPrefabComponents(GameObject* go, const rapidjson::Value
 
 			//std::cout << t->scaleX << " " << t->scaleY << " " << t->scaleZ << "scale\n\n";
 		}
+		t->markDirty();
 	}
 
 	// ---- Render ----
@@ -685,6 +686,7 @@ void PrefabManager::applyPrefabComponents(GameObject* go, const rapidjson::Value
 		}
 
 		r->hasAnimation = JsonIO::GetBoolOr(jr, "hasAnimation", false);
+		r->isStatic = JsonIO::GetBoolOr(jr, "static", false);
 		JsonIO::ReadVec3(jr, "clr", r->clr.r, r->clr.g, r->clr.b);
 
 		/*std::cout << r->hasTex << " has tex\n\n";
@@ -830,7 +832,7 @@ void PrefabManager::applyPrefabComponents(GameObject* go, const rapidjson::Value
 			tm->rows = tmj["rows"].GetInt();
 
 		// --- IMPORTANT: Deserialize actual tile data ---
-		tm->tiles.clear();  // wipe previous tile data
+		tm->clearTiles();  // wipe previous tile data
 
 		if (tmj.HasMember("tiles") && tmj["tiles"].IsArray())
 		{
@@ -899,6 +901,7 @@ void PrefabManager::serializeComponents(const GameObject* obj, rapidjson::Value&
 		if (r->hasTex && !r->texFile.empty())
 			jr.AddMember("texture", rapidjson::Value(r->texFile.c_str(), a), a);
 		jr.AddMember("hasAnimation", r->hasAnimation ? 1 : 0, a);
+		if (r->isStatic) jr.AddMember("static", 1, a);
 		if (r->clr.r != 1.f || r->clr.g != 1.f || r->clr.b != 1.f) {
 			JsonIO::WriteVec3(jr, "clr", r->clr.r, r->clr.g, r->clr.b, a);
 		}
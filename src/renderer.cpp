@@ -14,15 +14,47 @@ Technology is prohibited.
 /* End Header **************************************************************************/
 #include "renderer.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
 std::vector<renderer::model> renderer::models;
 //std::map<std::string, renderer::object> renderer::objects;
 std::vector<GLuint> renderer::shdr_pgm;
 renderer::camera renderer::cam;
 renderer::camera renderer::editorCam;
+renderer::InstanceRing renderer::instanceRing;
+renderer::InstanceStats renderer::instanceStats;
+renderer::DrawList renderer::drawList;
+renderer::MeshBuffer renderer::meshBuffer;
+GLuint renderer::frameDataBuffer = 0;
+renderer::FrameData renderer::frameData;
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/string_cast.hpp>
 
+namespace {
+	// meshBuffer's vertices and indices on a VAO, the mesh VAO and every static batch's
+	void setup_mesh_attributes(GLuint vao)
+	{
+		using MeshVertex = renderer::MeshVertex;
+		glVertexArrayVertexBuffer(vao, 0, renderer::meshBuffer.vbo, 0, sizeof(MeshVertex));
+		glVertexArrayElementBuffer(vao, renderer::meshBuffer.ebo);
+
+		glEnableVertexArrayAttrib(vao, 0);
+		glVertexArrayAttribFormat(vao, 0, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(MeshVertex, pos)));
+		glVertexArrayAttribBinding(vao, 0, 0);
+
+		glEnableVertexArrayAttrib(vao, 1);
+		glVertexArrayAttribFormat(vao, 1, 3, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(MeshVertex, clr)));
+		glVertexArrayAttribBinding(vao, 1, 0);
+
+		glEnableVertexArrayAttrib(vao, 2);
+		glVertexArrayAttribFormat(vao, 2, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(MeshVertex, tex)));
+		glVertexArrayAttribBinding(vao, 2, 0);
+	}
+}
+
 void renderer::init(int w, int h)
 {
 	// set up gameplay camera
@@ -33,10 +65,32 @@ void renderer::init(int w, int h)
 	editorCam.init(w, h);
 	editorCam.mode = cameraMode::EDITOR;
 
+	// the mesh VAO points its instance attributes at it
+	setup_instance_ring(16384);
+	setup_draw_list(256);
+
 	models.push_back(setup_square(glm::vec3(1.f, 1.f, 1.f)));
 	models.push_back(setup_circle(glm::vec3(1.f, 0.5f, 0.5f), 20));
 	models.push_back(setup_circle(glm::vec3(0.f, 0.f, 0.f), 20));
+	setup_mesh_buffer();
 	setup_shdrpgm();
+	setup_frame_data();
+}
+
+void renderer::initHeadless(int w, int h)
+{
+	cam.init(w, h);
+	cam.mode = cameraMode::GAME;
+
+	editorCam.init(w, h);
+	editorCam.mode = cameraMode::EDITOR;
+
+	// same slots as init, the ids stay 0 so cleanup has nothing to delete
+	for (shape s : { shape::square, shape::circle, shape::triangle }) {
+		model placeholder;
+		placeholder.shape = s;
+		models.push_back(placeholder);
+	}
 }
 
 void renderer::onResize(int w, int h)
@@ -59,133 +113,84 @@ renderer::model renderer::setup_square(glm::vec3 clr)
 	glm::vec2(-0.5f, 0.5f), glm::vec2(-0.5f, -0.5f)
 	};
 
-	std::array<glm::vec3, 4> clr_vtx{
-	clr, clr,
-	clr,clr
-	};
-
 	std::array<glm::vec2, 4> texpos{
 	glm::vec2(1.f, 0.f), glm::vec2(1.f,1.f),
 	glm::vec2(0.f, 1.f), glm::vec2(0.f, 0.f)
 	};
 
-	
-	GLsizei position_data_offset = 0;
-	GLsizei position_attribute_size = sizeof(glm::vec2);
-	GLsizei position_data_size = position_attribute_size * static_cast<GLsizei>(pos_vtx.size());
-	GLsizei color_data_offset = position_data_size;
-	GLsizei color_attribute_size = sizeof(glm::vec3);
-	GLsizei color_data_size = color_attribute_size * static_cast<GLsizei>(clr_vtx.size());
-	GLsizei texture_data_offset = position_data_size + color_data_size;
-	GLsizei texture_attibute_size = sizeof(glm::vec2);
-	GLsizei texture_data_size = texture_attibute_size * static_cast<GLsizei>(texpos.size());
-
-	glCreateBuffers(1, &mdl.vbo);
-	glNamedBufferStorage(mdl.vbo, position_data_size + color_data_size + texture_data_size, nullptr, GL_DYNAMIC_STORAGE_BIT);                     // immutable
-	glNamedBufferSubData(mdl.vbo, 0, position_data_size, pos_vtx.data());   // upload positions
-	glNamedBufferSubData(mdl.vbo, color_data_offset, color_data_size, clr_vtx.data());   // upload colors
-	glNamedBufferSubData(mdl.vbo, texture_data_offset, texture_data_size, texpos.data());   // upload colors
-
-	glCreateVertexArrays(1, &mdl.vaoid);
-	glEnableVertexArrayAttrib(mdl.vaoid, 0);
-	glVertexArrayVertexBuffer(mdl.vaoid, 0, mdl.vbo, position_data_offset, position_attribute_size);
-	glVertexArrayAttribFormat(mdl.vaoid, 0, 2, GL_FLOAT, GL_FALSE, 0);
-	glVertexArrayAttribBinding(mdl.vaoid, 0, 0);
-
-	glEnableVertexArrayAttrib(mdl.vaoid, 1);
-	glVertexArrayVertexBuffer(mdl.vaoid, 1, mdl.vbo, color_data_offset, color_attribute_size);
-	glVertexArrayAttribFormat(mdl.vaoid, 1, 3, GL_FLOAT, GL_FALSE, 0);
-	glVertexArrayAttribBinding(mdl.vaoid, 1, 1);
-
-	glEnableVertexArrayAttrib(mdl.vaoid, 2);
-	glVertexArrayVertexBuffer(mdl.vaoid, 2, mdl.vbo, texture_data_offset, texture_attibute_size);
-	glVertexArrayAttribFormat(mdl.vaoid, 2, 2, GL_FLOAT, GL_FALSE, 0);
-	glVertexArrayAttribBinding(mdl.vaoid, 2, 2);
-
-	//---------------------------------------------------------------------------------
-	//idk what im looking at, but hopefully gpt dun screw me over, to be refactored
-	//---------------------------------------------------------------------------------
-	// --- Setup instance buffer for per-instance attributes ---
-	glGenBuffers(1, &mdl.instanceVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, mdl.instanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, mdl.maxInstances * sizeof(InstanceData), nullptr, GL_DYNAMIC_DRAW);
-
-	// Setup layout in VAO
-	setup_instance_attributes(mdl);
+	std::array<GLushort, 6> idx_vtx{ 0, 1, 2, 2, 3, 0 };
+
+	// appended to the shared buffer, setup_mesh_buffer uploads it
+	mdl.base_vertex = static_cast<GLint>(meshBuffer.vertices.size());
+	mdl.first_index = static_cast<GLuint>(meshBuffer.indices.size());
+	for (size_t i = 0; i < pos_vtx.size(); ++i) {
+		meshBuffer.vertices.push_back(MeshVertex{ pos_vtx[i], clr, texpos[i] });
+	}
+	meshBuffer.indices.insert(meshBuffer.indices.end(), idx_vtx.begin(), idx_vtx.end());
 
 	mdl.primitive_type = GL_TRIANGLES;
-	std::array<GLushort, 6> idx_vtx{ 0, 1, 2, 2, 3, 0 };
 	mdl.elem_cnt = static_cast<GLuint>(idx_vtx.size());
-	GLuint ebo_hdl;
-	glCreateBuffers(1, &ebo_hdl);
-	glNamedBufferStorage(ebo_hdl, sizeof(GLushort) * mdl.elem_cnt, reinterpret_cast<GLvoid*>(idx_vtx.data()), GL_DYNAMIC_STORAGE_BIT);
-	glVertexArrayElementBuffer(mdl.vaoid, ebo_hdl);
-	mdl.ebo = ebo_hdl;
-	glBindVertexArray(0);
 	mdl.draw_cnt = static_cast<GLsizei>(pos_vtx.size());
 	mdl.primitive_cnt = mdl.elem_cnt;
 	mdl.shape = shape::square;
-	setup_instance_attributes(mdl);
 	return mdl;
 }
 
 renderer::model renderer::setup_circle(glm::vec3 clr, int slices)
 {
-	std::vector<glm::vec2> pos_vtx;
-	std::vector<glm::vec3> clr_vtx;
-	pos_vtx.reserve(slices + 2);
-	clr_vtx.reserve(slices + 2);
-	pos_vtx.emplace_back(0, 0);
-	clr_vtx.emplace_back(clr);
+	model mdl;
+	mdl.base_vertex = static_cast<GLint>(meshBuffer.vertices.size());
+	mdl.first_index = static_cast<GLuint>(meshBuffer.indices.size());
+
+	// center, then the rim with the first point repeated at the end
+	meshBuffer.vertices.push_back(MeshVertex{ glm::vec2(0, 0), clr, glm::vec2(0.5f, 0.5f) });
 	for (int i = 0; i < slices + 1; ++i)
 	{
 		float theta = glm::radians(360.0f * i / slices);
-		pos_vtx.emplace_back(cos(theta), sin(theta));
-		if (i == slices)
-		{
-			clr_vtx.emplace_back(clr_vtx[1]);
-		}
-		else
-		{
-			clr_vtx.emplace_back(clr.r, clr.g, clr.b);
+		glm::vec2 pos(cos(theta), sin(theta));
+		meshBuffer.vertices.push_back(MeshVertex{ pos, clr, pos * 0.5f + 0.5f });
+	}
 
-		}
+	// the old triangle fan as a triangle list, a multi draw has one primitive type
+	for (int i = 1; i <= slices; ++i)
+	{
+		meshBuffer.indices.push_back(0);
+		meshBuffer.indices.push_back(static_cast<GLushort>(i));
+		meshBuffer.indices.push_back(static_cast<GLushort>(i + 1));
 	}
-	model mdl;
-	GLsizei pos_size = static_cast<GLsizei>(sizeof(glm::vec2) * pos_vtx.size());
-	GLsizei clr_size = static_cast<GLsizei>(sizeof(glm::vec3) * clr_vtx.size());
-	// set up VAO as in GLApp::points_model
-	GLuint vbo_hdl;
-	glCreateBuffers(1, &vbo_hdl);
-	glNamedBufferStorage(vbo_hdl, pos_size + clr_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
-	glNamedBufferSubData(vbo_hdl, 0, pos_size, pos_vtx.data());
-	glNamedBufferSubData(vbo_hdl, pos_size, clr_size, clr_vtx.data());
-
-	glCreateVertexArrays(1, &mdl.vaoid);
-	glEnableVertexArrayAttrib(mdl.vaoid, 0);
-	glVertexArrayVertexBuffer(mdl.vaoid, 0, vbo_hdl, 0, sizeof(glm::vec2));
-	glVertexArrayAttribFormat(mdl.vaoid, 0, 2, GL_FLOAT, GL_FALSE, 0);
-	glVertexArrayAttribBinding(mdl.vaoid, 0, 0);
-	//gernerate color
-	glEnableVertexArrayAttrib(mdl.vaoid, 1);
-	glVertexArrayVertexBuffer(mdl.vaoid, 1, vbo_hdl, pos_size, sizeof(glm::vec3));
-	glVertexArrayAttribFormat(mdl.vaoid, 1, 3, GL_FLOAT, GL_FALSE, 0);
-	glVertexArrayAttribBinding(mdl.vaoid, 1, 1);
-
-	glGenBuffers(1, &mdl.instanceVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, mdl.instanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, mdl.maxInstances * sizeof(InstanceData), nullptr, GL_DYNAMIC_DRAW);
-	glBindVertexArray(0);
-	// and then set up the rest of object mdl ...
-	mdl.primitive_type = GL_TRIANGLE_FAN;
-	mdl.draw_cnt = static_cast<GLuint>(pos_vtx.size()); // number of vertices
-	mdl.elem_cnt = 0;       // no EBO
-	mdl.ebo = 0;
+
+	mdl.primitive_type = GL_TRIANGLES;
+	mdl.draw_cnt = static_cast<GLuint>(slices + 2); // number of vertices
+	mdl.elem_cnt = static_cast<GLuint>(slices * 3);
 	mdl.primitive_cnt = slices; // number of primitives
 	mdl.shape = shape::circle;
-	setup_instance_attributes(mdl);
 	return mdl;
 }
+
+void renderer::setup_mesh_buffer()
+{
+	GLsizeiptr vertexSize = static_cast<GLsizeiptr>(sizeof(MeshVertex) * meshBuffer.vertices.size());
+	GLsizeiptr indexSize = static_cast<GLsizeiptr>(sizeof(GLushort) * meshBuffer.indices.size());
+
+	glCreateBuffers(1, &meshBuffer.vbo);
+	glNamedBufferStorage(meshBuffer.vbo, vertexSize, meshBuffer.vertices.data(), 0);
+	glCreateBuffers(1, &meshBuffer.ebo);
+	glNamedBufferStorage(meshBuffer.ebo, indexSize, meshBuffer.indices.data(), 0);
+
+	glCreateVertexArrays(1, &meshBuffer.vao);
+	setup_mesh_attributes(meshBuffer.vao);
+	setup_instance_attributes(meshBuffer.vao, instanceRing.buffer);
+
+	// the buffers belong to meshBuffer, cleanup deletes them once
+	for (model& mdl : models) {
+		mdl.vaoid = meshBuffer.vao;
+	}
+
+	meshBuffer.vertices.clear();
+	meshBuffer.vertices.shrink_to_fit();
+	meshBuffer.indices.clear();
+	meshBuffer.indices.shrink_to_fit();
+}
 /*
 * 
 * create vao + vbo of quad
@@ -203,71 +208,317 @@ renderer::model renderer::setup_circle(glm::vec3 clr, int slices)
 */
 
 
-//---------------------------------------------------------------------------------
-//idk what im looking at, but hopefully gpt dun screw me over, to be refactored
-//---------------------------------------------------------------------------------
-void renderer::setup_instance_attributes(model& mdl)
+// per instance attributes, all from binding 3 (the instance ring, or a static batch's buffer).
+// which instances a draw reads is picked by its base instance, see queueInstances
+void renderer::setup_instance_attributes(GLuint vao, GLuint buffer)
 {
-	glBindVertexArray(mdl.vaoid);
-	glBindBuffer(GL_ARRAY_BUFFER, mdl.instanceVBO);
+	const GLuint binding = 3;
+	glVertexArrayVertexBuffer(vao, binding, buffer, 0, sizeof(InstanceData));
+	glVertexArrayBindingDivisor(vao, binding, 1);
+
+	// position, scale: locations 3, 4
+	glEnableVertexArrayAttrib(vao, 3);
+	glVertexArrayAttribFormat(vao, 3, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(InstanceData, position)));
+	glVertexArrayAttribBinding(vao, 3, binding);
+	glEnableVertexArrayAttrib(vao, 4);
+	glVertexArrayAttribFormat(vao, 4, 2, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(InstanceData, scale)));
+	glVertexArrayAttribBinding(vao, 4, binding);
+
+	// rotation and depth: location 5, snorm16 pair
+	glEnableVertexArrayAttrib(vao, 5);
+	glVertexArrayAttribFormat(vao, 5, 2, GL_SHORT, GL_TRUE, static_cast<GLuint>(offsetof(InstanceData, rotation)));
+	glVertexArrayAttribBinding(vao, 5, binding);
+
+	// color: location 6, RGBA8
+	glEnableVertexArrayAttrib(vao, 6);
+	glVertexArrayAttribFormat(vao, 6, 4, GL_UNSIGNED_BYTE, GL_TRUE, static_cast<GLuint>(offsetof(InstanceData, color)));
+	glVertexArrayAttribBinding(vao, 6, binding);
+
+	// texParams: location 7, unorm16 (still present for untextured; harmless)
+	glEnableVertexArrayAttrib(vao, 7);
+	glVertexArrayAttribFormat(vao, 7, 4, GL_UNSIGNED_SHORT, GL_TRUE, static_cast<GLuint>(offsetof(InstanceData, texParams)));
+	glVertexArrayAttribBinding(vao, 7, binding);
+
+	// texLayer, texSlot: locations 8, 9, read as integers
+	glEnableVertexArrayAttrib(vao, 8);
+	glVertexArrayAttribIFormat(vao, 8, 1, GL_UNSIGNED_SHORT, static_cast<GLuint>(offsetof(InstanceData, texLayer)));
+	glVertexArrayAttribBinding(vao, 8, binding);
+	glEnableVertexArrayAttrib(vao, 9);
+	glVertexArrayAttribIFormat(vao, 9, 1, GL_UNSIGNED_BYTE, static_cast<GLuint>(offsetof(InstanceData, texSlot)));
+	glVertexArrayAttribBinding(vao, 9, binding);
+}
+
+void renderer::queueInstances(const model& mdl, const std::vector<InstanceData>& instances, GLuint texture)
+{
+	if (instances.empty() || !instanceRing.mapped || !drawList.mapped)
+		return;
 
-	GLsizei stride = sizeof(InstanceData);
-	std::size_t offset = 0;
+	GLsizei count = static_cast<GLsizei>(instances.size());
 
-	// mat4 model: locations 3,4,5,6 (each is a vec4)
-	for (int i = 0; i < 4; ++i) {
-		glEnableVertexAttribArray(3 + i);
-		glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + i * sizeof(glm::vec4)));
-		glVertexAttribDivisor(3 + i, 1);
+	// writing past this frame's part would race the GPU on the next one, make the parts bigger.
+	// what is queued goes out first, it reads from the buffers being replaced
+	if (instanceRing.head + count > instanceRing.regionInstances) {
+		submitDrawList();
+		grow_instance_ring(instanceRing.head + count);
+		if (!instanceRing.mapped)
+			return;
+	}
+	if (drawList.head + 1 > drawList.regionCommands) {
+		submitDrawList();
+		grow_draw_list(drawList.head + 1);
+		if (!drawList.mapped)
+			return;
 	}
-	offset += sizeof(glm::mat4);
 
-	// color: location 7
-	glEnableVertexAttribArray(7);
-	glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, stride, (void*)offset);
-	glVertexAttribDivisor(7, 1);
-	offset += sizeof(glm::vec4);
+	// unit the texture sits on for the pending multi draw
+	int slot = 0;
+	if (texture) {
+		slot = static_cast<int>(std::find(drawList.textures.begin(), drawList.textures.begin() + drawList.textureCount, texture) - drawList.textures.begin());
+		if (slot == drawList.textureCount) {
+			if (drawList.textureCount == TEXTURE_SLOTS) {
+				submitDrawList();
+				slot = 0;
+			}
+			drawList.textures[drawList.textureCount++] = texture;
+		}
+	}
 
-	// texParams: location 8 (still present for untextured; harmless)
-	glEnableVertexAttribArray(8);
-	glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, stride, (void*)offset);
-	glVertexAttribDivisor(8, 1);
+	instanceStats.frameInstances += count;
+	++instanceStats.frameBatches;
+	instanceStats.largestBatch = std::max(instanceStats.largestBatch, count);
+	instanceStats.peakBatch = std::max(instanceStats.peakBatch, count);
+	instanceStats.peakFrame = std::max(instanceStats.peakFrame, instanceStats.frameInstances);
+
+	GLuint first = static_cast<GLuint>(instanceRing.region * instanceRing.regionInstances + instanceRing.head);
+	InstanceData* out = instanceRing.mapped + first;
+	if (texture) {
+		// whole instances written in order, the mapping is write combined
+		for (const InstanceData& instance : instances) {
+			*out = instance;
+			out->texSlot = static_cast<GLubyte>(slot);
+			++out;
+		}
+	}
+	else {
+		std::memcpy(out, instances.data(), count * sizeof(InstanceData));
+	}
+	instanceRing.head += count;
+
+	DrawElementsIndirectCommand& command = drawList.mapped[instanceRing.region * drawList.regionCommands + drawList.head];
+	command.count = mdl.elem_cnt;
+	command.instanceCount = static_cast<GLuint>(count);
+	command.firstIndex = mdl.first_index;
+	command.baseVertex = mdl.base_vertex;
+	command.baseInstance = first;
+	++drawList.head;
+}
 
-	glBindVertexArray(0);
+void renderer::submitDrawList()
+{
+	GLsizei pending = drawList.head - drawList.submitted;
+	if (pending > 0) {
+		if (drawList.textureCount > 0)
+			glBindTextures(0, drawList.textureCount, drawList.textures.data());
+
+		GLintptr offset = static_cast<GLintptr>(instanceRing.region * drawList.regionCommands + drawList.submitted) * sizeof(DrawElementsIndirectCommand);
+		glBindVertexArray(meshBuffer.vao);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, drawList.buffer);
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, reinterpret_cast<const void*>(offset), pending, 0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		glBindVertexArray(0);
+
+		++instanceStats.frameDrawCalls;
+	}
+
+	drawList.submitted = drawList.head;
+	drawList.textureCount = 0;
 }
 
-//---------------------------------------------------------------------------------
-//idk what im looking at, but hopefully gpt dun screw me over, to be refactored
-//---------------------------------------------------------------------------------
-void renderer::drawInstances(model& mdl, const std::vector<InstanceData>& instances)
+void renderer::setup_instance_ring(GLsizei regionInstances)
 {
-	if (instances.empty())
-		return;
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	GLsizeiptr size = static_cast<GLsizeiptr>(regionInstances) * FRAME_REGIONS * sizeof(InstanceData);
+
+	glCreateBuffers(1, &instanceRing.buffer);
+	glNamedBufferStorage(instanceRing.buffer, size, nullptr, flags);
+	instanceRing.mapped = static_cast<InstanceData*>(glMapNamedBufferRange(instanceRing.buffer, 0, size, flags));
+	if (!instanceRing.mapped) {
+		std::cerr << "[Renderer] Could not map the instance ring, nothing instanced will draw\n";
+	}
+
+	instanceRing.regionInstances = regionInstances;
+	instanceRing.region = 0;
+	instanceRing.head = 0;
+}
+
+void renderer::grow_instance_ring(GLsizei regionInstances)
+{
+	// doubling keeps a level that keeps getting busier from growing every frame
+	GLsizei grown = std::max(regionInstances, instanceRing.regionInstances * 2);
+	int region = instanceRing.region;
+
+	// the fences stay, they still guard the draw list's parts
+	glUnmapNamedBuffer(instanceRing.buffer);
+	glDeleteBuffers(1, &instanceRing.buffer);
 
-	glBindBuffer(GL_ARRAY_BUFFER, mdl.instanceVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0,
-		instances.size() * sizeof(InstanceData),
-		instances.data());
+	setup_instance_ring(grown);
+	instanceRing.region = region;
 
-	glBindVertexArray(mdl.vaoid);
+	const GLuint binding = 3;
+	if (meshBuffer.vao) glVertexArrayVertexBuffer(meshBuffer.vao, binding, instanceRing.buffer, 0, sizeof(InstanceData));
 
-	if (mdl.elem_cnt > 0) {
-		// Indexed path (square)
-		glDrawElementsInstanced(GL_TRIANGLES,
-			mdl.elem_cnt,
-			GL_UNSIGNED_SHORT,
-			nullptr,
-			static_cast<GLsizei>(instances.size()));
+	++instanceStats.grows;
+	std::cout << "[Renderer] Instance ring grown to " << grown << " instances per frame\n";
+}
+
+void renderer::setup_draw_list(GLsizei regionCommands)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	GLsizeiptr size = static_cast<GLsizeiptr>(regionCommands) * FRAME_REGIONS * sizeof(DrawElementsIndirectCommand);
+
+	glCreateBuffers(1, &drawList.buffer);
+	glNamedBufferStorage(drawList.buffer, size, nullptr, flags);
+	drawList.mapped = static_cast<DrawElementsIndirectCommand*>(glMapNamedBufferRange(drawList.buffer, 0, size, flags));
+	if (!drawList.mapped) {
+		std::cerr << "[Renderer] Could not map the draw list, nothing instanced will draw\n";
 	}
-	else {
-		// Non-indexed path (circle)
-		glDrawArraysInstanced(mdl.primitive_type,
-			0,
-			mdl.draw_cnt,
-			static_cast<GLsizei>(instances.size()));
+
+	drawList.regionCommands = regionCommands;
+	drawList.head = 0;
+	drawList.submitted = 0;
+	drawList.textureCount = 0;
+}
+
+void renderer::grow_draw_list(GLsizei regionCommands)
+{
+	GLsizei grown = std::max(regionCommands, drawList.regionCommands * 2);
+
+	// everything queued was just submitted, the old buffer lives on until the GPU is done with it
+	glUnmapNamedBuffer(drawList.buffer);
+	glDeleteBuffers(1, &drawList.buffer);
+	setup_draw_list(grown);
+
+	std::cout << "[Renderer] Draw list grown to " << grown << " commands per frame\n";
+}
+
+void renderer::beginInstanceFrame()
+{
+	instanceStats.frameInstances = 0;
+	instanceStats.frameBatches = 0;
+	instanceStats.largestBatch = 0;
+	instanceStats.frameDrawCalls = 0;
+	instanceStats.frameStaticBatches = 0;
+	instanceStats.frameStaticInstances = 0;
+
+	instanceRing.region = (instanceRing.region + 1) % FRAME_REGIONS;
+	instanceRing.head = 0;
+	drawList.head = 0;
+	drawList.submitted = 0;
+	drawList.textureCount = 0;
+
+	// the GPU is normally frames ahead of needing this, the wait only blocks when it is not
+	GLsync& fence = instanceRing.fences[instanceRing.region];
+	if (fence) {
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+			std::cerr << "[Renderer] Instance ring fence did not signal\n";
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
+
+void renderer::endInstanceFrame()
+{
+	GLsync& fence = instanceRing.fences[instanceRing.region];
+	if (fence) glDeleteSync(fence);
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void renderer::build_static_batch(StaticBatch& batch, const std::unordered_map<BatchKey, std::vector<InstanceData>, BatchKeyHash>& batches)
+{
+	destroy_static_batch(batch);
+	++instanceStats.staticBuilds;
+
+	std::vector<InstanceData> instances;
+	std::vector<DrawElementsIndirectCommand> commands;
+	for (const auto& [key, group] : batches) {
+		if (group.empty() || !key.texID) continue;
+
+		if (batch.passes.empty()) batch.passes.emplace_back();
+		StaticPass* pass = &batch.passes.back();
+		int slot = static_cast<int>(std::find(pass->textures.begin(), pass->textures.begin() + pass->textureCount, key.texID) - pass->textures.begin());
+		if (slot == pass->textureCount) {
+			// a new pass once the arrays no longer fit on the units
+			if (pass->textureCount == TEXTURE_SLOTS) {
+				batch.passes.emplace_back();
+				pass = &batch.passes.back();
+				pass->firstCommand = static_cast<GLsizei>(commands.size());
+				slot = 0;
+			}
+			pass->textures[pass->textureCount++] = key.texID;
+		}
+
+		const model& mdl = models[static_cast<int>(key.meshType)];
+		DrawElementsIndirectCommand command;
+		command.count = mdl.elem_cnt;
+		command.instanceCount = static_cast<GLuint>(group.size());
+		command.firstIndex = mdl.first_index;
+		command.baseVertex = mdl.base_vertex;
+		command.baseInstance = static_cast<GLuint>(instances.size());
+		commands.push_back(command);
+		++pass->commandCount;
+
+		for (const InstanceData& instance : group) {
+			instances.push_back(instance);
+			instances.back().texSlot = static_cast<GLubyte>(slot);
+		}
+	}
+
+	if (commands.empty()) {
+		batch.passes.clear();
+		return;
 	}
 
+	// immutable, the batch is made again rather than updated
+	glCreateBuffers(1, &batch.buffer);
+	glNamedBufferStorage(batch.buffer, static_cast<GLsizeiptr>(instances.size() * sizeof(InstanceData)), instances.data(), 0);
+	glCreateBuffers(1, &batch.commands);
+	glNamedBufferStorage(batch.commands, static_cast<GLsizeiptr>(commands.size() * sizeof(DrawElementsIndirectCommand)), commands.data(), 0);
+
+	glCreateVertexArrays(1, &batch.vao);
+	setup_mesh_attributes(batch.vao);
+	setup_instance_attributes(batch.vao, batch.buffer);
+
+	batch.instanceCount = static_cast<GLsizei>(instances.size());
+}
+
+void renderer::draw_static_batch(const StaticBatch& batch)
+{
+	if (!batch.vao) return;
+
+	glBindVertexArray(batch.vao);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, batch.commands);
+	for (const StaticPass& pass : batch.passes) {
+		glBindTextures(0, pass.textureCount, pass.textures.data());
+		GLintptr offset = static_cast<GLintptr>(pass.firstCommand) * sizeof(DrawElementsIndirectCommand);
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, reinterpret_cast<const void*>(offset), pass.commandCount, 0);
+		++instanceStats.frameDrawCalls;
+	}
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 	glBindVertexArray(0);
+
+	++instanceStats.frameStaticBatches;
+	instanceStats.frameStaticInstances += batch.instanceCount;
+}
+
+void renderer::destroy_static_batch(StaticBatch& batch)
+{
+	// a frame still drawing from them keeps them alive until the GPU is done
+	if (batch.vao) glDeleteVertexArrays(1, &batch.vao);
+	if (batch.buffer) glDeleteBuffers(1, &batch.buffer);
+	if (batch.commands) glDeleteBuffers(1, &batch.commands);
+	batch = StaticBatch{};
 }
 
 void renderer::setup_shdrpgm()
@@ -281,6 +532,40 @@ void renderer::setup_shdrpgm()
 	shdr_pgm.push_back(shader1);
 	shdr_pgm.push_back(shader2);
 
+	// uTex2d[i] samples unit i, the draw list binds its textures there
+	std::array<GLint, TEXTURE_SLOTS> units;
+	for (int i = 0; i < TEXTURE_SLOTS; ++i) units[i] = i;
+	GLint uTexLoc = ResourceManager::getInstance().getUniformLocation(shader1, "uTex2d");
+	if (uTexLoc != -1)
+		glProgramUniform1iv(shader1, uTexLoc, TEXTURE_SLOTS, units.data());
+
+}
+
+void renderer::setup_frame_data()
+{
+	glCreateBuffers(1, &frameDataBuffer);
+	glNamedBufferStorage(frameDataBuffer, sizeof(FrameData), &frameData, GL_DYNAMIC_STORAGE_BIT);
+	glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, frameDataBuffer);
+}
+
+void renderer::updateFrameData(const glm::mat4& view, const glm::mat4& proj, float deltaTime, const glm::vec2& resolution)
+{
+	frameData.view = view;
+	frameData.proj = proj;
+	frameData.time += deltaTime;
+	frameData.deltaTime = deltaTime;
+	frameData.resolution = resolution;
+	if (frameDataBuffer) glNamedBufferSubData(frameDataBuffer, 0, sizeof(FrameData), &frameData);
+}
+
+void renderer::updateFrameCamera(const glm::mat4& view, const glm::mat4& proj)
+{
+	if (view == frameData.view && proj == frameData.proj) return;
+
+	frameData.view = view;
+	frameData.proj = proj;
+	// the two matrices are the start of the block
+	if (frameDataBuffer) glNamedBufferSubData(frameDataBuffer, 0, 2 * sizeof(glm::mat4), &frameData);
 }
 
 void renderer::camera::init(int w, int h)
@@ -326,14 +611,30 @@ void renderer::camera::zoomInOut(float scrollDelta) {
 }
 
 void renderer::cleanup() {
-	// Clean up all models
-	for (auto& model : models) {
-		if (model.vaoid) glDeleteVertexArrays(1, &model.vaoid);
-		if (model.vbo) glDeleteBuffers(1, &model.vbo);
-		if (model.ebo) glDeleteBuffers(1, &model.ebo);
-		if (model.instanceVBO) glDeleteBuffers(1, &model.instanceVBO);
-	}
+	// Clean up all models, they share the mesh buffer
 	models.clear();
+	if (meshBuffer.vao) glDeleteVertexArrays(1, &meshBuffer.vao);
+	if (meshBuffer.vbo) glDeleteBuffers(1, &meshBuffer.vbo);
+	if (meshBuffer.ebo) glDeleteBuffers(1, &meshBuffer.ebo);
+	meshBuffer = MeshBuffer{};
+
+	// the ring, unmapped before it goes
+	for (GLsync& fence : instanceRing.fences) {
+		if (fence) glDeleteSync(fence);
+		fence = nullptr;
+	}
+	if (instanceRing.buffer) {
+		glUnmapNamedBuffer(instanceRing.buffer);
+		glDeleteBuffers(1, &instanceRing.buffer);
+	}
+	instanceRing = InstanceRing{};
+	if (drawList.buffer) {
+		glUnmapNamedBuffer(drawList.buffer);
+		glDeleteBuffers(1, &drawList.buffer);
+	}
+	drawList = DrawList{};
+	if (frameDataBuffer) glDeleteBuffers(1, &frameDataBuffer);
+	frameDataBuffer = 0;
 
 	// Clean up shader programs
 	for (GLuint program : shdr_pgm) {